@@ -0,0 +1,54 @@
+#pragma once
+
+
+#include <string>
+#include <functional>
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Totals for every allocation made through global operator new and delete since the game started.
+struct Allocation_Counts
+{
+    long long allocation_count;
+    long long allocated_bytes;
+    long long deallocation_count;
+    long long deallocated_bytes;
+};
+
+
+// How many components of a type are alive and the memory they held when they were built, including memory their members
+// allocated.
+struct Component_Footprint
+{
+    std::string type;
+    long long live_count;
+    long long live_bytes;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Allocations are only counted when the game is built with GAME_ALLOCATION_TRACKING defined, which replaces global
+// operator new and delete; otherwise every count stays 0.
+bool is_allocation_tracking();
+Allocation_Counts get_allocation_counts();
+
+// Bytes allocated and not yet freed, so work that frees what it allocates nets to 0 however much it churned.
+long long get_live_allocated_bytes();
+
+void track_component_footprint(const std::string & type, int count, long long bytes);
+void iterate_component_footprints(const std::function<void(const Component_Footprint &)> & callback);
+
+
+} // namespace Game
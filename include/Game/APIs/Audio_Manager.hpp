@@ -14,7 +14,9 @@ namespace Game
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void audio_manager_api_init();
-void play_sound(const std::string & path, float volume);
+void audio_manager_update();
+int load_sound(const std::string & path);
+void play_sound(int sound, float volume, int priority);
 
 
 } // namespace Game
@@ -0,0 +1,42 @@
+#pragma once
+
+
+#include <string>
+#include <glm/glm.hpp>
+
+#include "Game/APIs/Timer_Wheel.hpp"
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// One shooter's progress through a bullet pattern: how many volleys it has fired, which the pattern's rate and spin
+// follow, and the cooldown before its next volley. Emitters must be value-initialized before use.
+struct Bullet_Emitter
+{
+    int volley;
+    Timer_Handle cooldown;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bullet_patterns_api_init();
+
+bool emit_bullet_pattern(
+    const std::string & pattern_name,
+    Bullet_Emitter & emitter,
+    const glm::vec3 & origin,
+    const glm::vec3 & aim_direction);
+
+
+} // namespace Game
@@ -0,0 +1,38 @@
+#pragma once
+
+
+#include <string>
+#include <functional>
+#include "Cpp_Utils/JSON.hpp"
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Parses and validates a data file, throwing if it's invalid, and returns a function that swaps the parsed data into
+// place. Loaders are called from the watcher thread when a file is reloaded, so they must not touch game state outside
+// of the returned function.
+using Data_File_Loader = std::function<std::function<void()>(const Cpp_Utils::JSON &)>;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void data_reloader_api_init();
+void data_reloader_api_shutdown();
+void data_reloader_update();
+void load_data_file(const std::string & path, const Data_File_Loader & loader);
+
+// Blueprints aren't reloaded, so they're read once at init and loaders can check names against them from any thread.
+const Cpp_Utils::JSON & get_blueprints_data();
+
+
+} // namespace Game
@@ -0,0 +1,23 @@
+#pragma once
+
+
+#include <string>
+
+#include "Game/APIs/Enemy_Manager.hpp"
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void drop_table_api_init();
+const std::string * sample_item_drop(Enemies enemy);
+const std::string * get_droppable_item_name(const std::string & name);
+
+
+} // namespace Game
@@ -1,16 +1,53 @@
 #pragma once
 
 
+#include <map>
+#include <vector>
+#include "Nito/APIs/ECS.hpp"
+
+
 namespace Game
 {
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum class Enemies
+{
+    TURRET,
+    TILE_TURRET,
+    WALL_LAUNCHER,
+    BOSS,
+    NONE,
+};
+
+
+struct Enemy_Group
+{
+    std::vector<Enemies> enemies;
+    std::vector<int> layouts;
+};
+
+
+using Enemy_Groups = std::map<int, Enemy_Group>;
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Interface
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void generate_enemies();
+void generate_enemy_groups();
+void spawn_enemies();
+void spawn_room_enemies(int room);
+void release_room_enemies(int room);
+void track_enemy(Nito::Entity enemy_entity, Enemies enemy, int room);
+const Enemy_Groups & get_enemy_groups();
+void set_enemy_groups(const Enemy_Groups & enemy_groups);
 
 
 } // namespace Game
@@ -2,6 +2,9 @@
 
 
 #include <string>
+#include <vector>
+#include <map>
+#include <cstdint>
 #include <functional>
 #include <glm/glm.hpp>
 #include "Nito/APIs/ECS.hpp"
@@ -39,6 +42,15 @@ enum class Tile_Types
 };
 
 
+struct Tile_Type_Properties
+{
+    bool is_wall;
+    bool is_walkable;
+    bool is_door;
+};
+
+
+// An unpacked view of a room tile.
 struct Tile
 {
     Tile_Types type;
@@ -47,21 +59,185 @@ struct Tile
 };
 
 
+// How room tiles are stored: the rotation is packed as quarter turns in the low bits of flags, and the room is taken
+// from the floor's room layout.
+struct Packed_Tile
+{
+    uint8_t type;
+    uint8_t flags;
+};
+
+
+static_assert(sizeof(Packed_Tile) == 2, "Packed_Tile must stay 2 bytes!");
+
+
+// A door out of a room, at the room tile coordinates of the door on the room's side.
+struct Room_Door
+{
+    int room;
+    glm::ivec2 coordinates;
+};
+
+
+// A room's slice of the floor's room graph, iterated in place rather than copied.
+template<typename Value>
+struct Room_Graph_Range
+{
+    const Value * first;
+    const Value * last;
+};
+
+
+using Possible_Rooms = std::map<int *, glm::ivec2>;
+
+
+struct Floor
+{
+    int size;
+    int room_tiles_width;
+    int * rooms;
+    int * room_obstacle_layouts;
+    Packed_Tile * room_tiles;
+    Possible_Rooms possible_rooms;
+};
+
+
+struct Room_Floor_Tiles
+{
+    int begin;
+    int count;
+    int free_count;
+};
+
+
+struct Room_Tile_Entity
+{
+    Nito::Entity entity;
+    Tile_Types type;
+};
+
+
+// A world's floor and everything derived from it.
+struct Floor_Manager_State
+{
+    Floor current_floor;
+    glm::vec2 spawn_position;
+    std::map<int, Room_Data> room_datas;
+    std::map<int, std::vector<Nito::Entity>> room_enemies;
+    std::map<int, std::vector<Nito::Entity>> room_exits;
+    int max_room_id;
+
+
+    // Rooms connected by doors, in compressed sparse row form: a room's doors are
+    // room_doors[room_door_offsets[room]..room_door_offsets[room + 1]], and its distinct neighbors and the room grid
+    // coordinates of its sections are stored the same way. Room depths are how many doors away from the spawn room each
+    // room is.
+    std::vector<int> room_door_offsets;
+    std::vector<Room_Door> room_doors;
+    std::vector<int> room_neighbor_offsets;
+    std::vector<int> room_neighbors;
+    std::vector<int> room_section_offsets;
+    std::vector<glm::ivec2> room_sections;
+    std::vector<int> room_depths;
+    int max_room_depth;
+
+
+    // Tile entities of each built room, and released tile entities kept per type so building a room reuses them
+    // instead of loading new ones.
+    std::map<int, std::vector<Room_Tile_Entity>> built_room_tiles;
+    std::map<Tile_Types, std::vector<Nito::Entity>> tile_pools;
+
+
+    // Floor tiles grouped by room, with each room's free tiles kept at the front of its range so a free tile can be
+    // sampled in constant time and occupying/releasing a tile is a single swap.
+    std::vector<glm::ivec2> floor_tiles;
+    std::vector<Room_Floor_Tiles> room_floor_tiles;
+    std::vector<int> floor_tile_slots;
+    std::vector<int> floor_tile_occupant_counts;
+    std::map<Nito::Entity, glm::ivec2> floor_tile_occupants;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Indexed by Tile_Types, so entries must stay in the same order as the enum.
+constexpr Tile_Type_Properties TILE_TYPE_PROPERTIES[]
+{
+    // is_wall  is_walkable  is_door
+    { true    , false      , false }, // WALL
+    { true    , false      , false }, // WALL_CORNER
+    { true    , false      , false }, // WALL_CORNER_INNER
+    { true    , false      , false }, // LEFT_DOOR_WALL
+    { true    , false      , false }, // RIGHT_DOOR_WALL
+    { false   , false      , true  }, // DOOR
+    { false   , true       , false }, // FLOOR
+    { false   , false      , false }, // FLOOR_LEDGE
+    { false   , false      , false }, // FLOOR_HOLE
+    { false   , true       , false }, // NEXT_FLOOR
+    { false   , false      , false }, // NONE
+};
+
+
+static_assert(
+    sizeof(TILE_TYPE_PROPERTIES) / sizeof(Tile_Type_Properties) == (size_t)Tile_Types::NONE + 1,
+    "TILE_TYPE_PROPERTIES must have an entry for every Tile_Types value!");
+
+
+constexpr uint8_t PACKED_TILE_ROTATION_MASK = 0x3;
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Interface
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void floor_manager_api_init();
+void set_obstacle_layouts(const std::vector<std::vector<int>> & obstacle_layouts);
 void generate_floor(int floor_size);
+void generate_floor_layout(int floor_size);
+void generate_floor_rooms(int floor_size);
+void generate_floor_tiles();
+void load_floor_layout(
+    int floor_size,
+    const int * rooms,
+    const int * room_obstacle_layouts,
+    const Packed_Tile * room_tiles);
+
+void build_floor();
+void build_room(int room);
+void release_room(int room);
+bool is_room_built(int room);
+std::vector<int> get_built_rooms();
+std::vector<int> get_room_neighborhood(int room);
+
+// Splits a streaming floor's move to room into the built rooms no longer door-adjacent to it, which are released first
+// so their tiles can be reused, and the rooms of its neighborhood that still need building.
+void get_room_stream_changes(
+    int room,
+    const std::vector<int> & built_rooms,
+    std::vector<int> & released_rooms,
+    std::vector<int> & unbuilt_rooms);
+
+Room_Graph_Range<int> get_room_neighbors(int room);
+Room_Graph_Range<Room_Door> get_room_doors(int room);
+Room_Graph_Range<glm::ivec2> get_room_sections(int room);
+int get_room_depth(int room);
+int get_max_room_depth();
+void set_floor_streaming(bool floor_streaming);
+bool is_floor_streaming();
 void destroy_floor();
 const glm::vec2 & get_spawn_position();
 int get_room(int x, int y);
 int get_room(const glm::vec3 & position);
 const Room_Data & get_room_data(int room);
-const Tile & get_room_tile(int x, int y);
+int get_room_obstacle_layout(int x, int y);
+Tile get_room_tile(int x, int y);
+const Packed_Tile * get_packed_room_tiles();
 void iterate_rooms(const std::function<void(int, int, int &)> & callback);
-void iterate_room_tiles(const std::function<void(int, int, Tile &)> & callback);
+void iterate_room_tiles(const std::function<void(int, int, const Tile &)> & callback);
 int get_floor_size();
 int get_room_tile_width();
 int get_room_tile_height();
@@ -70,11 +246,49 @@ int get_max_room_id();
 int get_spawn_room_id();
 void add_enemy(int room_id, Nito::Entity enemy);
 void remove_enemy(int room_id, Nito::Entity enemy);
+const std::vector<Nito::Entity> & get_room_enemies(int room_id);
+int get_room_enemy_count(int room_id);
 int get_enemy_room(Nito::Entity enemy);
 glm::ivec2 get_room_tile_coordinates(const glm::vec2 & position);
 glm::vec2 get_room_tile_position(const glm::ivec2 & coordinates);
+void occupy_floor_tile(Nito::Entity occupant, const glm::ivec2 & coordinates);
+bool occupy_random_floor_tile(Nito::Entity occupant, int room, glm::ivec2 & coordinates);
+void release_floor_tile(Nito::Entity occupant);
+int get_free_floor_tile_count(int room);
 void add_floor_generated_handler(const std::string & id, const std::function<void()> & handler);
 void remove_floor_generated_handler(const std::string & id);
 
 
+constexpr bool is_wall(Tile_Types tile_type)
+{
+    return TILE_TYPE_PROPERTIES[(int)tile_type].is_wall;
+}
+
+
+constexpr bool is_walkable(Tile_Types tile_type)
+{
+    return TILE_TYPE_PROPERTIES[(int)tile_type].is_walkable;
+}
+
+
+constexpr bool is_door(Tile_Types tile_type)
+{
+    return TILE_TYPE_PROPERTIES[(int)tile_type].is_door;
+}
+
+
+template<typename Value>
+const Value * begin(const Room_Graph_Range<Value> & range)
+{
+    return range.first;
+}
+
+
+template<typename Value>
+const Value * end(const Room_Graph_Range<Value> & range)
+{
+    return range.last;
+}
+
+
 } // namespace Game
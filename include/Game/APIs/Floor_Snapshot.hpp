@@ -0,0 +1,23 @@
+#pragma once
+
+
+#include <string>
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void save_floor_snapshot(const std::string & path);
+void load_floor_snapshot(const std::string & path);
+
+// Restores only a snapshot's floor layout and enemy groups, without building the floor or spawning its entities.
+void load_floor_snapshot_layout(const std::string & path);
+
+
+} // namespace Game
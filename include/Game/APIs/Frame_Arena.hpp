@@ -0,0 +1,96 @@
+#pragma once
+
+
+#include <cstddef>
+#include <vector>
+#include <map>
+#include <functional>
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// A position in the current thread's frame arena that it can be rewound to.
+struct Frame_Arena_Mark
+{
+    int block;
+    std::size_t offset;
+};
+
+
+// Rewinds the frame arena to where it was when the scope was entered, for transient containers that don't need to live
+// until the end of the frame, such as those used while generating a floor.
+struct Frame_Arena_Scope
+{
+    const Frame_Arena_Mark mark;
+
+    Frame_Arena_Scope();
+    ~Frame_Arena_Scope();
+    Frame_Arena_Scope(const Frame_Arena_Scope &) = delete;
+    Frame_Arena_Scope & operator=(const Frame_Arena_Scope &) = delete;
+};
+
+
+// Hands out memory from the frame arena. Memory is never freed individually, only when the arena is reset at the next
+// frame or rewound by the scope it was allocated in, so containers using it must not outlive either.
+template<typename Value>
+struct Frame_Allocator
+{
+    using value_type = Value;
+
+    Frame_Allocator() = default;
+
+    template<typename Other_Value>
+    Frame_Allocator(const Frame_Allocator<Other_Value> & /*other*/) {}
+
+    Value * allocate(std::size_t count);
+    void deallocate(Value * /*values*/, std::size_t /*count*/) {}
+};
+
+
+// A Frame_Vector created in an outer scope must not grow inside an inner scope: its new storage is allocated past the
+// inner scope's mark, so it's handed out again once the inner scope rewinds while the vector still uses it.
+template<typename Value>
+using Frame_Vector = std::vector<Value, Frame_Allocator<Value>>;
+
+
+template<typename Key, typename Value>
+using Frame_Map = std::map<Key, Value, std::less<Key>, Frame_Allocator<std::pair<const Key, Value>>>;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void frame_arena_update();
+void * allocate_frame_memory(std::size_t size, std::size_t alignment);
+Frame_Arena_Mark get_frame_arena_mark();
+void rewind_frame_arena(const Frame_Arena_Mark & mark);
+std::size_t get_frame_arena_capacity();
+
+
+template<typename Value, typename Other_Value>
+bool operator==(const Frame_Allocator<Value> & /*a*/, const Frame_Allocator<Other_Value> & /*b*/)
+{
+    return true;
+}
+
+
+template<typename Value, typename Other_Value>
+bool operator!=(const Frame_Allocator<Value> & /*a*/, const Frame_Allocator<Other_Value> & /*b*/)
+{
+    return false;
+}
+
+
+} // namespace Game
+
+
+#include "Game/APIs/Frame_Arena.ipp"
@@ -0,0 +1,12 @@
+namespace Game
+{
+
+
+template<typename Value>
+Value * Frame_Allocator<Value>::allocate(std::size_t count)
+{
+    return (Value *)allocate_frame_memory(count * sizeof(Value), alignof(Value));
+}
+
+
+} // namespace Game
@@ -11,7 +11,9 @@ namespace Game
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void minimap_api_init();
+void generate_minimap_layout();
 void generate_minimap();
+int get_minimap_room_count();
 void destroy_minimap();
 
 
@@ -0,0 +1,40 @@
+#pragma once
+
+
+#include <functional>
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Refers to a scheduled timer. A timer's handle goes stale once it expires or is cancelled, even if its slot is reused
+// by a later timer, so handles can be held onto and checked safely. Value-initialized handles refer to no timer.
+struct Timer_Handle
+{
+    int index;
+    int generation;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void timer_wheel_update();
+
+// Moves the wheel on by an amount of game time, running every timer that expires along the way.
+void timer_wheel_advance(float time);
+
+Timer_Handle schedule_timer(float delay, const std::function<void()> & callback = nullptr);
+void cancel_timer(const Timer_Handle & timer_handle);
+bool is_timer_pending(const Timer_Handle & timer_handle);
+
+
+} // namespace Game
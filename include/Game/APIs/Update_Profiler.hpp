@@ -0,0 +1,52 @@
+#pragma once
+
+
+#include <string>
+#include <functional>
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Time spent and memory allocated in an update handler since profiles were last reset. Allocations are only counted
+// while allocation tracking is built in.
+struct Update_Profile
+{
+    std::string name;
+    double total_time;
+    int sample_count;
+    long long allocation_count;
+    long long allocated_bytes;
+};
+
+
+// Wraps an update handler so the time it takes and what it allocates are recorded under its name while update
+// profiling is enabled. The handler's profile is only looked up on its first call.
+#define GAME_PROFILED_UPDATE_HANDLER(handler)                                              \
+    []() -> void                                                                           \
+    {                                                                                      \
+        static Game::Update_Profile & update_profile = Game::get_update_profile(#handler); \
+        Game::run_profiled_update_handler(update_profile, handler);                        \
+    }
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Update_Profile & get_update_profile(const std::string & name);
+void run_profiled_update_handler(Update_Profile & update_profile, void (* handler)());
+void set_update_profiling(bool update_profiling);
+bool is_update_profiling();
+void reset_update_profiles();
+void iterate_update_profiles(const std::function<void(const Update_Profile &)> & callback);
+
+
+} // namespace Game
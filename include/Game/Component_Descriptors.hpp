@@ -0,0 +1,77 @@
+#pragma once
+
+
+#include <string>
+#include <vector>
+#include "Cpp_Utils/JSON.hpp"
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum class Field_Rules
+{
+    REQUIRED,
+    OPTIONAL,
+};
+
+
+template<typename Component, typename Value>
+struct Field
+{
+    const char * name;
+    Value Component::* member;
+    Field_Rules rules;
+};
+
+
+template<typename Enum>
+struct Enum_Name
+{
+    const char * name;
+    Enum value;
+};
+
+
+// Specialized alongside each component with a constexpr fields() returning a tuple of Fields. Optional fields keep the
+// component's default member initializer when missing from the component's JSON data.
+template<typename Component>
+struct Component_Descriptor;
+
+
+// Specialized alongside each enum used by a component field with a constexpr names() returning an array of Enum_Names.
+template<typename Enum>
+struct Enum_Descriptor;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename Component, typename Value>
+constexpr Field<Component, Value> field(const char * name, Value Component::* member, Field_Rules rules);
+
+template<typename Enum>
+Enum parse_enum(const std::string & name);
+
+template<typename Component>
+Component * parse_component(const Cpp_Utils::JSON & data);
+
+template<typename Component>
+void serialize_component(const Component & component, std::vector<char> & buffer);
+
+template<typename Component>
+Component * deserialize_component(const char *& bytes, const char * bytes_end);
+
+
+} // namespace Game
+
+
+#include "Game/Component_Descriptors.ipp"
@@ -0,0 +1,389 @@
+#include <map>
+#include <tuple>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+#include <initializer_list>
+#include <glm/glm.hpp>
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// JSON Field Values
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename Value>
+void parse_field_value(const Cpp_Utils::JSON & data, Value & value, std::true_type /*is_enum*/)
+{
+    value = parse_enum<Value>(data.get<std::string>());
+}
+
+
+template<typename Value>
+void parse_field_value(const Cpp_Utils::JSON & data, Value & value, std::false_type /*is_enum*/)
+{
+    value = data.get<Value>();
+}
+
+
+template<typename Value>
+void parse_field_value(const Cpp_Utils::JSON & data, Value & value)
+{
+    parse_field_value(data, value, std::is_enum<Value>());
+}
+
+
+inline void parse_field_value(const Cpp_Utils::JSON & data, glm::vec3 & value)
+{
+    for (auto axis_data = data.begin(); axis_data != data.end(); axis_data++)
+    {
+        const std::string & axis = axis_data.key();
+        const int axis_index = axis == "x" ? 0 : axis == "y" ? 1 : axis == "z" ? 2 : -1;
+
+        if (axis_index != -1)
+        {
+            value[axis_index] = axis_data.value().template get<float>();
+        }
+    }
+}
+
+
+template<typename Key, typename Value>
+void parse_field_value(const Cpp_Utils::JSON & data, std::map<Key, Value> & value)
+{
+    for (auto entry_data = data.begin(); entry_data != data.end(); entry_data++)
+    {
+        parse_field_value(entry_data.value(), value[parse_enum<Key>(entry_data.key())]);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Binary Field Values
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Arithmetic and enum values are stored as their raw bytes; strings and containers are prefixed with a uint32_t count.
+// Reads never go past bytes_end, throwing instead if the data ends before the value does.
+template<typename Value>
+using Is_Raw_Field_Value = std::integral_constant<bool, std::is_arithmetic<Value>::value || std::is_enum<Value>::value>;
+
+
+template<typename Value>
+void write_field_value(const Value & value, std::vector<char> & buffer);
+
+template<typename Value>
+void read_field_value(const char *& bytes, const char * bytes_end, Value & value);
+
+
+inline void check_field_bytes(const char * bytes, const char * bytes_end, std::size_t size)
+{
+    if ((std::size_t)(bytes_end - bytes) < size)
+    {
+        throw std::runtime_error("ERROR: component data ends before its fields do!");
+    }
+}
+
+
+template<typename Value>
+void write_field_value(const Value & value, std::vector<char> & buffer, std::true_type /*is_raw*/)
+{
+    const char * bytes = reinterpret_cast<const char *>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(Value));
+}
+
+
+template<typename Value>
+void read_field_value(const char *& bytes, const char * bytes_end, Value & value, std::true_type /*is_raw*/)
+{
+    check_field_bytes(bytes, bytes_end, sizeof(Value));
+    std::memcpy(&value, bytes, sizeof(Value));
+    bytes += sizeof(Value);
+}
+
+
+// Every stored value takes at least a byte, so a count can't be larger than the bytes left; checking this up front
+// keeps corrupt counts from allocating huge containers.
+inline uint32_t read_field_value_count(const char *& bytes, const char * bytes_end)
+{
+    uint32_t count;
+    read_field_value(bytes, bytes_end, count, std::true_type());
+    check_field_bytes(bytes, bytes_end, count);
+    return count;
+}
+
+
+inline void write_field_value(const std::string & value, std::vector<char> & buffer, std::false_type /*is_raw*/)
+{
+    write_field_value((uint32_t)value.size(), buffer, std::true_type());
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+
+inline void read_field_value(
+    const char *& bytes,
+    const char * bytes_end,
+    std::string & value,
+    std::false_type /*is_raw*/)
+{
+    const uint32_t size = read_field_value_count(bytes, bytes_end);
+    value.assign(bytes, size);
+    bytes += size;
+}
+
+
+inline void write_field_value(const glm::vec3 & value, std::vector<char> & buffer, std::false_type /*is_raw*/)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        write_field_value(value[i], buffer, std::true_type());
+    }
+}
+
+
+inline void read_field_value(
+    const char *& bytes,
+    const char * bytes_end,
+    glm::vec3 & value,
+    std::false_type /*is_raw*/)
+{
+    for (int i = 0; i < 3; i++)
+    {
+        read_field_value(bytes, bytes_end, value[i], std::true_type());
+    }
+}
+
+
+template<typename Value>
+void write_field_value(const std::vector<Value> & value, std::vector<char> & buffer, std::false_type /*is_raw*/)
+{
+    write_field_value((uint32_t)value.size(), buffer);
+
+    for (const Value & element : value)
+    {
+        write_field_value(element, buffer);
+    }
+}
+
+
+template<typename Value>
+void read_field_value(
+    const char *& bytes,
+    const char * bytes_end,
+    std::vector<Value> & value,
+    std::false_type /*is_raw*/)
+{
+    value.resize(read_field_value_count(bytes, bytes_end));
+
+    for (Value & element : value)
+    {
+        read_field_value(bytes, bytes_end, element);
+    }
+}
+
+
+template<typename Key, typename Value>
+void write_field_value(const std::map<Key, Value> & value, std::vector<char> & buffer, std::false_type /*is_raw*/)
+{
+    write_field_value((uint32_t)value.size(), buffer);
+
+    for (const auto & entry : value)
+    {
+        write_field_value(entry.first, buffer);
+        write_field_value(entry.second, buffer);
+    }
+}
+
+
+template<typename Key, typename Value>
+void read_field_value(
+    const char *& bytes,
+    const char * bytes_end,
+    std::map<Key, Value> & value,
+    std::false_type /*is_raw*/)
+{
+    const uint32_t size = read_field_value_count(bytes, bytes_end);
+    value.clear();
+
+    for (uint32_t i = 0; i < size; i++)
+    {
+        Key key;
+        read_field_value(bytes, bytes_end, key);
+        read_field_value(bytes, bytes_end, value[key]);
+    }
+}
+
+
+template<typename Value>
+void write_field_value(const Value & value, std::vector<char> & buffer)
+{
+    write_field_value(value, buffer, Is_Raw_Field_Value<Value>());
+}
+
+
+template<typename Value>
+void read_field_value(const char *& bytes, const char * bytes_end, Value & value)
+{
+    read_field_value(bytes, bytes_end, value, Is_Raw_Field_Value<Value>());
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Fields
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename Component>
+using Component_Fields = decltype(Component_Descriptor<Component>::fields());
+
+
+template<typename Component>
+using Component_Field_Indexes = std::make_index_sequence<std::tuple_size<Component_Fields<Component>>::value>;
+
+
+template<typename Component, typename Value>
+bool parse_field(
+    const std::string & key,
+    const Cpp_Utils::JSON & data,
+    Component & component,
+    const Field<Component, Value> & field,
+    int index,
+    uint32_t & parsed_fields)
+{
+    if (key != field.name)
+    {
+        return false;
+    }
+
+    parse_field_value(data, component.*field.member);
+    parsed_fields |= 1u << index;
+    return true;
+}
+
+
+template<typename Component, typename Value>
+void check_required_field(const Field<Component, Value> & field, int index, uint32_t parsed_fields)
+{
+    if (field.rules == Field_Rules::REQUIRED && (parsed_fields & (1u << index)) == 0)
+    {
+        throw std::runtime_error("ERROR: required component field \"" + std::string(field.name) + "\" is missing!");
+    }
+}
+
+
+template<typename Component, std::size_t ... Indexes>
+Component * parse_component(const Cpp_Utils::JSON & data, std::index_sequence<Indexes ...>)
+{
+    static_assert(sizeof...(Indexes) <= 32, "component descriptors are limited to 32 fields");
+
+    constexpr auto fields = Component_Descriptor<Component>::fields();
+    std::unique_ptr<Component> component(new Component());
+    uint32_t parsed_fields = 0u;
+
+
+    // Match each key of the component's data against the descriptor's fields in a single pass over the data.
+    for (auto field_data = data.begin(); field_data != data.end(); field_data++)
+    {
+        const std::string & key = field_data.key();
+        const Cpp_Utils::JSON & value_data = field_data.value();
+        bool parsed = false;
+
+        (void)std::initializer_list<int>
+        {
+            (
+                parsed =
+                    parsed ||
+                    parse_field(key, value_data, *component, std::get<Indexes>(fields), Indexes, parsed_fields),
+                0
+            ) ...
+        };
+    }
+
+    (void)std::initializer_list<int>
+    {
+        (check_required_field(std::get<Indexes>(fields), Indexes, parsed_fields), 0) ...
+    };
+    return component.release();
+}
+
+
+template<typename Component, std::size_t ... Indexes>
+void serialize_component(const Component & component, std::vector<char> & buffer, std::index_sequence<Indexes ...>)
+{
+    constexpr auto fields = Component_Descriptor<Component>::fields();
+    (void)std::initializer_list<int>
+    {
+        (write_field_value(component.*std::get<Indexes>(fields).member, buffer), 0) ...
+    };
+}
+
+
+template<typename Component, std::size_t ... Indexes>
+Component * deserialize_component(const char *& bytes, const char * bytes_end, std::index_sequence<Indexes ...>)
+{
+    constexpr auto fields = Component_Descriptor<Component>::fields();
+    std::unique_ptr<Component> component(new Component());
+    (void)std::initializer_list<int>
+    {
+        (read_field_value(bytes, bytes_end, component.get()->*std::get<Indexes>(fields).member), 0) ...
+    };
+    return component.release();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename Component, typename Value>
+constexpr Field<Component, Value> field(const char * name, Value Component::* member, Field_Rules rules)
+{
+    return { name, member, rules };
+}
+
+
+template<typename Enum>
+Enum parse_enum(const std::string & name)
+{
+    for (const Enum_Name<Enum> & enum_name : Enum_Descriptor<Enum>::names())
+    {
+        if (name == enum_name.name)
+        {
+            return enum_name.value;
+        }
+    }
+
+    throw std::runtime_error("ERROR: \"" + name + "\" is not a valid enum name!");
+}
+
+
+template<typename Component>
+Component * parse_component(const Cpp_Utils::JSON & data)
+{
+    return parse_component<Component>(data, Component_Field_Indexes<Component>());
+}
+
+
+template<typename Component>
+void serialize_component(const Component & component, std::vector<char> & buffer)
+{
+    serialize_component(component, buffer, Component_Field_Indexes<Component>());
+}
+
+
+template<typename Component>
+Component * deserialize_component(const char *& bytes, const char * bytes_end)
+{
+    return deserialize_component<Component>(bytes, bytes_end, Component_Field_Indexes<Component>());
+}
+
+
+} // namespace Game
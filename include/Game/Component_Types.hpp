@@ -0,0 +1,85 @@
+#pragma once
+
+
+#include <string>
+#include <vector>
+#include "Nito/APIs/ECS.hpp"
+#include "Nito/Components.hpp"
+#include "Nito/Collider_Component.hpp"
+
+#include "Game/Components.hpp"
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Tags for components stored as plain values, which can't be looked up by their value type.
+struct Layers {};
+struct Target_Id {};
+struct Enemy_Enabled {};
+
+
+// Maps a component type or tag to the type of its stored value and its name, which is built once and shared by every
+// lookup so accessing a component never constructs a string.
+template<typename Type>
+struct Component_Type;
+
+
+#define GAME_COMPONENT_TYPE(TYPE, VALUE, NAME) \
+    template<> \
+    struct Component_Type<TYPE> \
+    { \
+        using Value = VALUE; \
+        \
+        static const std::string & name() \
+        { \
+            static const std::string COMPONENT_NAME(NAME); \
+            return COMPONENT_NAME; \
+        } \
+    };
+
+GAME_COMPONENT_TYPE(Nito::Transform                , Nito::Transform                , "transform")
+GAME_COMPONENT_TYPE(Nito::UI_Transform             , Nito::UI_Transform             , "ui_transform")
+GAME_COMPONENT_TYPE(Nito::Dimensions               , Nito::Dimensions               , "dimensions")
+GAME_COMPONENT_TYPE(Nito::Sprite                   , Nito::Sprite                   , "sprite")
+GAME_COMPONENT_TYPE(Nito::Light_Source             , Nito::Light_Source             , "light_source")
+GAME_COMPONENT_TYPE(Nito::Collider                 , Nito::Collider                 , "collider")
+GAME_COMPONENT_TYPE(Nito::Circle_Collider          , Nito::Circle_Collider          , "circle_collider")
+GAME_COMPONENT_TYPE(Player_Controller              , Player_Controller              , "player_controller")
+GAME_COMPONENT_TYPE(Projectile                     , Projectile                     , "projectile")
+GAME_COMPONENT_TYPE(Orientation_Handler            , Orientation_Handler            , "orientation_handler")
+GAME_COMPONENT_TYPE(Health                         , Health                         , "health")
+GAME_COMPONENT_TYPE(Menu_Buttons_Handler           , Menu_Buttons_Handler           , "menu_buttons_handler")
+GAME_COMPONENT_TYPE(Room_Exit                      , Room_Exit                      , "room_exit")
+GAME_COMPONENT_TYPE(Enemy_Projectile_Launcher      , Enemy_Projectile_Launcher      , "enemy_projectile_launcher")
+GAME_COMPONENT_TYPE(Item                           , Item                           , "item")
+GAME_COMPONENT_TYPE(Health_Item                    , Health_Item                    , "health_item")
+GAME_COMPONENT_TYPE(Layers                         , std::vector<std::string>       , "layers")
+GAME_COMPONENT_TYPE(Target_Id                      , std::string                    , "target_id")
+GAME_COMPONENT_TYPE(Enemy_Enabled                  , bool                           , "enemy_enabled")
+
+#undef GAME_COMPONENT_TYPE
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename Type>
+typename Component_Type<Type>::Value * component(Nito::Entity entity);
+
+template<typename Type>
+bool has(Nito::Entity entity);
+
+
+} // namespace Game
+
+
+#include "Game/Component_Types.ipp"
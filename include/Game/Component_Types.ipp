@@ -0,0 +1,19 @@
+namespace Game
+{
+
+
+template<typename Type>
+typename Component_Type<Type>::Value * component(Nito::Entity entity)
+{
+    return (typename Component_Type<Type>::Value *)Nito::get_component(entity, Component_Type<Type>::name());
+}
+
+
+template<typename Type>
+bool has(Nito::Entity entity)
+{
+    return Nito::has_component(entity, Component_Type<Type>::name());
+}
+
+
+} // namespace Game
@@ -2,11 +2,16 @@
 
 
 #include <map>
+#include <array>
+#include <tuple>
+#include <vector>
 #include <string>
 #include <functional>
 #include <glm/glm.hpp>
 #include "Nito/APIs/ECS.hpp"
 
+#include "Game/Component_Descriptors.hpp"
+
 
 namespace Game
 {
@@ -26,6 +31,22 @@ enum class Orientation
 };
 
 
+template<>
+struct Enum_Descriptor<Orientation>
+{
+    static constexpr std::array<Enum_Name<Orientation>, 4> names()
+    {
+        return
+        {{
+            { "left"  , Orientation::LEFT  },
+            { "up"    , Orientation::UP    },
+            { "right" , Orientation::RIGHT },
+            { "down"  , Orientation::DOWN  },
+        }};
+    }
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Components
@@ -37,6 +58,7 @@ struct Player_Controller
     {
         CONTROLLER,
         KEYBOARD_MOUSE,
+        BOT,
     };
 
     float speed;
@@ -45,25 +67,79 @@ struct Player_Controller
 };
 
 
+template<>
+struct Enum_Descriptor<Player_Controller::Modes>
+{
+    static constexpr std::array<Enum_Name<Player_Controller::Modes>, 3> names()
+    {
+        return
+        {{
+            { "controller"     , Player_Controller::Modes::CONTROLLER     },
+            { "keyboard_mouse" , Player_Controller::Modes::KEYBOARD_MOUSE },
+            { "bot"            , Player_Controller::Modes::BOT            },
+        }};
+    }
+};
+
+
+template<>
+struct Component_Descriptor<Player_Controller>
+{
+    static constexpr auto fields()
+    {
+        return std::make_tuple(
+            field("speed"           , &Player_Controller::speed           , Field_Rules::REQUIRED),
+            field("stick_dead_zone" , &Player_Controller::stick_dead_zone , Field_Rules::REQUIRED),
+            field("mode"            , &Player_Controller::mode            , Field_Rules::REQUIRED));
+    }
+};
+
+
 struct Projectile
 {
-    float speed;
+    float speed = 1.0f;
     glm::vec3 direction;
-    float duration;
-    float damage;
-    std::vector<std::string> target_layers;
+    float duration = 1.0f;
+    float damage = 10.0f;
+    const std::vector<std::string> * target_layers = nullptr;
     std::vector<std::string> ignore_layers;
 };
 
 
+template<>
+struct Component_Descriptor<Projectile>
+{
+    static constexpr auto fields()
+    {
+        return std::make_tuple(
+            field("speed"         , &Projectile::speed         , Field_Rules::OPTIONAL),
+            field("direction"     , &Projectile::direction     , Field_Rules::OPTIONAL),
+            field("duration"      , &Projectile::duration      , Field_Rules::OPTIONAL),
+            field("damage"        , &Projectile::damage        , Field_Rules::OPTIONAL),
+            field("ignore_layers" , &Projectile::ignore_layers , Field_Rules::OPTIONAL));
+    }
+};
+
+
 struct Orientation_Handler
 {
-    Orientation orientation;
-    glm::vec3 look_direction;
+    Orientation orientation = Orientation::DOWN;
+    glm::vec3 look_direction = glm::vec3(0.0f, -1.0f, 0.0f);
     std::map<Orientation, std::string> orientation_texture_paths;
 };
 
 
+template<>
+struct Component_Descriptor<Orientation_Handler>
+{
+    static constexpr auto fields()
+    {
+        return std::make_tuple(
+            field("texture_paths", &Orientation_Handler::orientation_texture_paths, Field_Rules::REQUIRED));
+    }
+};
+
+
 struct Health
 {
     float max;
@@ -79,6 +155,16 @@ struct Menu_Buttons_Handler
 };
 
 
+template<>
+struct Component_Descriptor<Menu_Buttons_Handler>
+{
+    static constexpr auto fields()
+    {
+        return std::make_tuple(field("button_names", &Menu_Buttons_Handler::button_names, Field_Rules::REQUIRED));
+    }
+};
+
+
 struct Room_Exit
 {
     enum class Types
@@ -88,21 +174,60 @@ struct Room_Exit
     };
 
     Types type;
-    bool locked;
+    bool locked = false;
     std::string locked_texture_path;
 };
 
 
+template<>
+struct Enum_Descriptor<Room_Exit::Types>
+{
+    static constexpr std::array<Enum_Name<Room_Exit::Types>, 2> names()
+    {
+        return
+        {{
+            { "door"       , Room_Exit::Types::DOOR       },
+            { "next_floor" , Room_Exit::Types::NEXT_FLOOR },
+        }};
+    }
+};
+
+
+template<>
+struct Component_Descriptor<Room_Exit>
+{
+    static constexpr auto fields()
+    {
+        return std::make_tuple(
+            field("type"                , &Room_Exit::type                , Field_Rules::REQUIRED),
+            field("locked_texture_path" , &Room_Exit::locked_texture_path , Field_Rules::REQUIRED));
+    }
+};
+
+
 struct Enemy_Projectile_Launcher
 {
-    bool enabled;
-    float cooldown_time;
+    bool enabled = true;
     float range;
-    std::string projectile_name;
+    std::string bullet_pattern;
     std::map<Orientation, glm::vec3> orientation_offsets;
 };
 
 
+template<>
+struct Component_Descriptor<Enemy_Projectile_Launcher>
+{
+    static constexpr auto fields()
+    {
+        return std::make_tuple(
+            field("enabled"             , &Enemy_Projectile_Launcher::enabled             , Field_Rules::OPTIONAL),
+            field("range"               , &Enemy_Projectile_Launcher::range               , Field_Rules::REQUIRED),
+            field("bullet_pattern"      , &Enemy_Projectile_Launcher::bullet_pattern      , Field_Rules::REQUIRED),
+            field("orientation_offsets" , &Enemy_Projectile_Launcher::orientation_offsets , Field_Rules::REQUIRED));
+    }
+};
+
+
 struct Item
 {
     std::function<bool(Nito::Entity)> pick_up_handler;
@@ -115,4 +240,14 @@ struct Health_Item
 };
 
 
+template<>
+struct Component_Descriptor<Health_Item>
+{
+    static constexpr auto fields()
+    {
+        return std::make_tuple(field("health_restored", &Health_Item::health_restored, Field_Rules::REQUIRED));
+    }
+};
+
+
 } // namespace Game
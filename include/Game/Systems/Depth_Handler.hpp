@@ -16,6 +16,7 @@ namespace Game
 void depth_handler_subscribe(Nito::Entity entity);
 void depth_handler_unsubscribe(Nito::Entity entity);
 void depth_handler_update();
+void set_depth_dirty(Nito::Entity entity);
 
 
 } // namespace Game
@@ -25,6 +25,8 @@ void game_manager_add_room_change_handler(
 
 void game_manager_remove_room_change_handler(const std::string & id);
 void game_manager_complete_floor();
+void game_manager_save_floor(const std::string & path);
+void game_manager_load_floor(const std::string & path);
 void game_manager_track_render_flag(int room, Nito::Entity entity);
 void game_manager_untrack_render_flag(int room, Nito::Entity entity);
 void game_manager_track_collider_enabled_flag(int room, Nito::Entity entity);
@@ -34,5 +36,8 @@ void game_manager_untrack_enemy_enabled_flag(int room, Nito::Entity entity);
 void game_manager_track_light_source_enabled_flag(int room, Nito::Entity entity);
 void game_manager_untrack_light_source_enabled_flag(int room, Nito::Entity entity);
 
+// Re-applies a room's enabled state to every flag tracked in it, for entities added to a room after it was entered.
+void game_manager_refresh_room_flags(int room);
+
 
 } // namespace Game
@@ -1,8 +1,13 @@
 #pragma once
 
 
+#include <string>
+#include <functional>
+#include <glm/glm.hpp>
 #include "Nito/APIs/ECS.hpp"
 
+#include "Game/APIs/Enemy_Manager.hpp"
+
 
 namespace Game
 {
@@ -13,10 +18,11 @@ namespace Game
 // Interface
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void item_init();
 void item_subscribe(Nito::Entity entity);
 void item_unsubscribe(Nito::Entity entity);
-void check_spawn_item(Nito::Entity entity);
+void check_spawn_item(Enemies enemy, int room, const glm::vec3 & position);
+void spawn_item(const std::string & name, int room, const glm::vec3 & position);
+void iterate_items(const std::function<void(const std::string &, int, const glm::vec3 &)> & callback);
 
 
 } // namespace Game
@@ -0,0 +1,22 @@
+#pragma once
+
+
+#include "Nito/APIs/ECS.hpp"
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void light_handler_subscribe(Nito::Entity entity);
+void light_handler_unsubscribe(Nito::Entity entity);
+void light_handler_update();
+bool * get_light_room_enabled_flag(Nito::Entity entity);
+
+
+} // namespace Game
@@ -1,13 +1,46 @@
 #pragma once
 
 
+#include <string>
+#include <vector>
+#include <functional>
+#include <glm/glm.hpp>
 #include "Nito/APIs/ECS.hpp"
+#include "Nito/Components.hpp"
+
+#include "Game/Components.hpp"
 
 
 namespace Game
 {
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Settings shared by every projectile in a volley, applied as each one is loaded from the volley's blueprint. Target
+// layers are pointed to rather than copied, so they must outlive the volley's projectiles.
+struct Projectile_Volley
+{
+    std::string blueprint_name;
+    const std::vector<std::string> * target_layers;
+    float duration;
+    float damage_modifier;
+};
+
+
+// Where one projectile in a volley starts, the normalized direction it travels in and how much its blueprint's speed is
+// scaled by.
+struct Projectile_Spawn
+{
+    glm::vec3 origin;
+    glm::vec3 direction;
+    float speed_modifier;
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Interface
@@ -16,6 +49,8 @@ namespace Game
 void projectile_subscribe(Nito::Entity entity);
 void projectile_unsubscribe(Nito::Entity entity);
 void projectile_update();
+void projectile_spawn_volley(const Projectile_Volley & volley, const Projectile_Spawn * spawns, int spawn_count);
+void projectile_iterate(const std::function<void(const Nito::Transform &, const Projectile &)> & callback);
 
 
 } // namespace Game
@@ -13,9 +13,9 @@ namespace Game
 // Interface
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void boss_segment_subscribe(Nito::Entity entity);
-void boss_segment_unsubscribe(Nito::Entity entity);
-void boss_segment_update();
+void stress_benchmark_subscribe(Nito::Entity entity);
+void stress_benchmark_unsubscribe(Nito::Entity entity);
+void stress_benchmark_update();
 
 
 } // namespace Game
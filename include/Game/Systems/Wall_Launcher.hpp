@@ -2,6 +2,8 @@
 
 
 #include <vector>
+#include <functional>
+#include <glm/glm.hpp>
 #include "Nito/APIs/ECS.hpp"
 
 
@@ -9,16 +11,51 @@ namespace Game
 {
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct Wall_Segment
+{
+    int room;
+    int tile_positions_begin;
+    int tile_position_count;
+    Nito::Entity wall_launcher;
+};
+
+
+struct Wall_Segment_Range
+{
+    int begin;
+    int count;
+};
+
+
+// A world's wall segments, which wall launchers patrol.
+struct Wall_Launcher_State
+{
+    std::vector<glm::vec2> wall_segment_tile_positions;
+    std::vector<Wall_Segment> wall_segments;
+    std::vector<Wall_Segment_Range> room_wall_segment_ranges;
+    std::vector<glm::ivec2> room_wall_tiles;
+    int floor_room_tile_width;
+    int floor_room_tile_height;
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Interface
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void wall_launcher_init();
+void generate_wall_segments();
+void iterate_wall_segments(const std::function<void(int, const glm::vec2 *, int)> & callback);
 void wall_launcher_subscribe(Nito::Entity entity);
 void wall_launcher_unsubscribe(Nito::Entity entity);
 void wall_launcher_update();
-std::vector<Nito::Entity> wall_launcher_generate(int room, int room_origin_x, int room_origin_y);
+std::vector<Nito::Entity> wall_launcher_generate(int room, int room_origin_x, int room_origin_y, int layout);
 
 
 } // namespace Game
@@ -17,15 +17,9 @@ namespace Game
 // Interface
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void fire_projectile(
-    const std::string & name,
-    const glm::vec3 & origin,
-    const glm::vec3 & direction,
-    float duration,
-    const std::vector<std::string> & target_layers,
-    float damage_modifier = 1.0f);
-
 int random(int min, int max);
+float random(float min, float max);
+void seed_random(unsigned int seed);
 bool in_layer(Nito::Entity entity, const std::string & layer);
 
 template<typename T>
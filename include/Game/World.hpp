@@ -0,0 +1,43 @@
+#pragma once
+
+
+#include <random>
+
+#include "Game/APIs/Floor_Manager.hpp"
+#include "Game/APIs/Enemy_Manager.hpp"
+#include "Game/Systems/Wall_Launcher.hpp"
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The state of one simulated run: its random numbers, floor, enemy groups and wall segments. Each thread simulates the
+// world set for it, so several seeded runs can be simulated at once without sharing state. Entity component state is
+// still shared, as Nito has a single entity registry, so only one world per process can build entities. Worlds must be
+// value-initialized (World world {}) before use.
+struct World
+{
+    std::minstd_rand random_engine;
+    bool random_seeded;
+    Floor_Manager_State floor_manager;
+    Enemy_Groups enemy_groups;
+    Wall_Launcher_State wall_launcher;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+World & get_world();
+void set_world(World & world);
+
+
+} // namespace Game
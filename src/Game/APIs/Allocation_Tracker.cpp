@@ -0,0 +1,212 @@
+#include "Game/APIs/Allocation_Tracker.hpp"
+
+#include <map>
+#include <string>
+#include <atomic>
+#include <new>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include "Cpp_Utils/Map.hpp"
+#include "Cpp_Utils/Collection.hpp"
+
+
+using std::map;
+using std::string;
+using std::atomic;
+using std::function;
+using std::size_t;
+using std::max_align_t;
+using std::bad_alloc;
+using std::nothrow_t;
+
+// Cpp_Utils/Map.hpp
+using Cpp_Utils::contains_key;
+
+// Cpp_Utils/Collection.hpp
+using Cpp_Utils::for_each;
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Allocations can come from any thread, such as the data reloader's watcher thread.
+static atomic<long long> allocation_count(0);
+static atomic<long long> allocated_bytes(0);
+static atomic<long long> deallocation_count(0);
+static atomic<long long> deallocated_bytes(0);
+
+static map<string, Component_Footprint> component_footprints;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+bool is_allocation_tracking()
+{
+#ifdef GAME_ALLOCATION_TRACKING
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+Allocation_Counts get_allocation_counts()
+{
+    return
+    {
+        allocation_count,
+        allocated_bytes,
+        deallocation_count,
+        deallocated_bytes,
+    };
+}
+
+
+long long get_live_allocated_bytes()
+{
+    return allocated_bytes - deallocated_bytes;
+}
+
+
+void track_component_footprint(const string & type, int count, long long bytes)
+{
+    if (!contains_key(component_footprints, type))
+    {
+        component_footprints[type] = { type, 0, 0 };
+    }
+
+    Component_Footprint & component_footprint = component_footprints[type];
+    component_footprint.live_count += count;
+    component_footprint.live_bytes += bytes;
+}
+
+
+void iterate_component_footprints(const function<void(const Component_Footprint &)> & callback)
+{
+    for_each(component_footprints, [&](const string & /*type*/, const Component_Footprint & component_footprint) -> void
+    {
+        callback(component_footprint);
+    });
+}
+
+
+} // namespace Game
+
+
+#ifdef GAME_ALLOCATION_TRACKING
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Allocation Tracking
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Each allocation is prefixed with its size so deallocations can count the bytes they free. The prefix keeps the
+// memory handed out aligned for any type.
+static const size_t ALLOCATION_HEADER_SIZE = alignof(max_align_t);
+
+
+static void * track_allocation(size_t size)
+{
+    char * memory = (char *)malloc(ALLOCATION_HEADER_SIZE + (size == 0 ? 1 : size));
+
+    if (memory == nullptr)
+    {
+        return nullptr;
+    }
+
+    *(size_t *)memory = size;
+    Game::allocation_count.fetch_add(1, std::memory_order_relaxed);
+    Game::allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    return memory + ALLOCATION_HEADER_SIZE;
+}
+
+
+static void track_deallocation(void * memory)
+{
+    if (memory == nullptr)
+    {
+        return;
+    }
+
+    char * allocation = (char *)memory - ALLOCATION_HEADER_SIZE;
+    Game::deallocation_count.fetch_add(1, std::memory_order_relaxed);
+    Game::deallocated_bytes.fetch_add(*(size_t *)allocation, std::memory_order_relaxed);
+    free(allocation);
+}
+
+
+void * operator new(size_t size)
+{
+    void * memory = track_allocation(size);
+
+    if (memory == nullptr)
+    {
+        throw bad_alloc();
+    }
+
+    return memory;
+}
+
+
+void * operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+
+void * operator new(size_t size, const nothrow_t & /*tag*/) noexcept
+{
+    return track_allocation(size);
+}
+
+
+void * operator new[](size_t size, const nothrow_t & /*tag*/) noexcept
+{
+    return track_allocation(size);
+}
+
+
+void operator delete(void * memory) noexcept
+{
+    track_deallocation(memory);
+}
+
+
+void operator delete[](void * memory) noexcept
+{
+    track_deallocation(memory);
+}
+
+
+void operator delete(void * memory, size_t /*size*/) noexcept
+{
+    track_deallocation(memory);
+}
+
+
+void operator delete[](void * memory, size_t /*size*/) noexcept
+{
+    track_deallocation(memory);
+}
+
+
+void operator delete(void * memory, const nothrow_t & /*tag*/) noexcept
+{
+    track_deallocation(memory);
+}
+
+
+void operator delete[](void * memory, const nothrow_t & /*tag*/) noexcept
+{
+    track_deallocation(memory);
+}
+#endif
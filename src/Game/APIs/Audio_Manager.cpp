@@ -5,6 +5,7 @@
 #include "Nito/APIs/Audio.hpp"
 #include "Nito/APIs/Scene.hpp"
 #include "Cpp_Utils/String.hpp"
+#include "Cpp_Utils/Map.hpp"
 #include "Cpp_Utils/Collection.hpp"
 
 
@@ -26,6 +27,9 @@ using Nito::set_scene_load_handler;
 // Cpp_Utils/String.hpp
 using Cpp_Utils::to_string;
 
+// Cpp_Utils/Map.hpp
+using Cpp_Utils::contains_key;
+
 // Cpp_Utils/Collection.hpp
 using Cpp_Utils::for_each;
 
@@ -46,6 +50,22 @@ struct Scene_Music
 };
 
 
+struct Sound
+{
+    string path;
+    int last_played_frame;
+};
+
+
+struct Voice
+{
+    string audio_source_id;
+    int sound;
+    int priority;
+    int start_frame;
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Data
@@ -53,8 +73,14 @@ struct Scene_Music
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static const string SCENE_CHANGE_HANDLER_ID("audio_manager_api");
 static const float GLOBAL_VOLUME = 0.1f;
+static const int VOICE_COUNT = 16;
 static string current_music_id;
-static vector<string> sound_audio_source_pool;
+static vector<Sound> sounds;
+static map<string, int> sound_handles;
+static vector<Voice> voices;
+static vector<int> free_voices;
+static vector<int> active_voices;
+static int frame = 0;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -74,6 +100,57 @@ static void play_music(const string & music_id)
 }
 
 
+static void create_voices()
+{
+    voices.resize(VOICE_COUNT);
+
+    for (int i = 0; i < VOICE_COUNT; i++)
+    {
+        Voice & voice = voices[i];
+        voice.audio_source_id = "sound_voice " + to_string(i);
+        voice.sound = -1;
+        voice.priority = 0;
+        voice.start_frame = 0;
+        create_audio_source(voice.audio_source_id);
+        free_voices.push_back(i);
+    }
+}
+
+
+// Returns the index into active_voices of the lowest priority voice, preferring the oldest among equals, or -1 if every
+// active voice outranks priority.
+static int find_voice_to_steal(int priority)
+{
+    int steal_index = -1;
+
+    for (size_t i = 0; i < active_voices.size(); i++)
+    {
+        const Voice & voice = voices[active_voices[i]];
+
+        if (voice.priority > priority)
+        {
+            continue;
+        }
+
+        if (steal_index == -1)
+        {
+            steal_index = i;
+            continue;
+        }
+
+        const Voice & steal_voice = voices[active_voices[steal_index]];
+
+        if (voice.priority < steal_voice.priority ||
+            (voice.priority == steal_voice.priority && voice.start_frame < steal_voice.start_frame))
+        {
+            steal_index = i;
+        }
+    }
+
+    return steal_index;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Interface
@@ -95,36 +172,103 @@ void audio_manager_api_init()
 }
 
 
-void play_sound(const string & path, float volume = GLOBAL_VOLUME)
+void audio_manager_update()
 {
-#if __gnu_linux__
-    string sound_audio_source_id;
+    frame++;
 
 
-    // Check for an existing audio source that isn't playing to be used to play the sound.
-    for (const string & sound_audio_source_pool_id : sound_audio_source_pool)
+    // Return voices that have finished playing to the free list.
+    for (size_t i = 0; i < active_voices.size();)
     {
-        if (!audio_source_playing(sound_audio_source_pool_id))
+        const int voice_index = active_voices[i];
+
+        if (audio_source_playing(voices[voice_index].audio_source_id))
         {
-            sound_audio_source_id = sound_audio_source_pool_id;
-            break;
+            i++;
+            continue;
         }
+
+        active_voices[i] = active_voices.back();
+        active_voices.pop_back();
+        free_voices.push_back(voice_index);
+    }
+}
+
+
+int load_sound(const string & path)
+{
+    if (contains_key(sound_handles, path))
+    {
+        return sound_handles.at(path);
+    }
+
+    const int sound = sounds.size();
+    sounds.push_back({ path, -1 });
+    sound_handles[path] = sound;
+    return sound;
+}
+
+
+void play_sound(int sound, float volume, int priority)
+{
+#if __gnu_linux__
+    Sound & sound_data = sounds.at(sound);
+
+
+    // Silent sounds and sounds that have already started this frame would only take up voices.
+    if (volume <= 0.0f || sound_data.last_played_frame == frame)
+    {
+        return;
     }
 
 
-    // If an existing audio source in the sound audio source pool couldn't be found that wasn't currently playing,
-    // create a new audio source and add it to the pool.
-    if (sound_audio_source_id.empty())
+    // Voices are created on first use so audio sources aren't created before the engine's audio is ready.
+    if (voices.empty())
     {
-        sound_audio_source_id = "sound_audio_source " + to_string(sound_audio_source_pool.size());
-        sound_audio_source_pool.push_back(sound_audio_source_id);
-        create_audio_source(sound_audio_source_id);
+        create_voices();
     }
 
 
-    set_audio_source_buffer(sound_audio_source_id, path);
-    set_audio_source_volume(sound_audio_source_id, volume);
-    play_audio_source(sound_audio_source_id);
+    int voice_index;
+
+    if (!free_voices.empty())
+    {
+        voice_index = free_voices.back();
+        free_voices.pop_back();
+        active_voices.push_back(voice_index);
+    }
+    else
+    {
+        const int steal_index = find_voice_to_steal(priority);
+
+
+        // Every voice is playing something more important.
+        if (steal_index == -1)
+        {
+            return;
+        }
+
+        voice_index = active_voices[steal_index];
+        stop_audio_source(voices[voice_index].audio_source_id);
+    }
+
+
+    Voice & voice = voices[voice_index];
+    const string & audio_source_id = voice.audio_source_id;
+
+
+    // Only rebind the voice's buffer when it last played a different sound.
+    if (voice.sound != sound)
+    {
+        set_audio_source_buffer(audio_source_id, sound_data.path);
+        voice.sound = sound;
+    }
+
+    voice.priority = priority;
+    voice.start_frame = frame;
+    sound_data.last_played_frame = frame;
+    set_audio_source_volume(audio_source_id, volume);
+    play_audio_source(audio_source_id);
 #endif
 }
 
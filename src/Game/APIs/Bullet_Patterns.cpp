@@ -0,0 +1,352 @@
+#include "Game/APIs/Bullet_Patterns.hpp"
+
+#include <map>
+#include <set>
+#include <vector>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include <cmath>
+#include <algorithm>
+#include <glm/glm.hpp>
+#include "Cpp_Utils/JSON.hpp"
+#include "Cpp_Utils/Map.hpp"
+
+#include "Game/APIs/Data_Reloader.hpp"
+#include "Game/APIs/Frame_Arena.hpp"
+#include "Game/Systems/Projectile.hpp"
+
+
+using std::map;
+using std::set;
+using std::vector;
+using std::string;
+using std::function;
+using std::runtime_error;
+using std::atan2;
+using std::cos;
+using std::sin;
+using std::round;
+using std::min;
+
+// glm/glm.hpp
+using glm::vec3;
+using glm::vec2;
+using glm::radians;
+using glm::degrees;
+
+// Cpp_Utils/JSON.hpp
+using Cpp_Utils::JSON;
+
+// Cpp_Utils/Map.hpp
+using Cpp_Utils::contains_key;
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+enum class Bullet_Pattern_Shapes
+{
+    AIMED,
+    SPREAD,
+    RING,
+    SPIRAL,
+};
+
+
+// A value that ramps linearly from start to end, over a volley's bullets or over a number of volleys.
+struct Bullet_Pattern_Curve
+{
+    float start;
+    float end;
+    int volleys;
+};
+
+
+// Each volley fires count bullets around the aim direction, which is first snapped to a multiple of aim_snap degrees
+// if set. Bullets start origin_offset along their direction from the emitter's origin, scaled per axis.
+struct Bullet_Pattern
+{
+    Projectile_Volley volley;
+    Bullet_Pattern_Shapes shape;
+    int count;
+    float angle;
+    float spin;
+    float aim_snap;
+    vec2 origin_offset;
+    Bullet_Pattern_Curve speed;
+    Bullet_Pattern_Curve rate;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Fired by name from Player_Controller and Boss.
+static const vector<string> CODE_BULLET_PATTERNS { "player_orb", "boss_head", "boss_segment" };
+
+
+static map<string, Bullet_Pattern> bullet_patterns;
+
+
+// Every pattern the game fires by name, from code or blueprints, which reloaded bullet patterns must all still contain.
+// Only set before the bullet patterns file is watched, so loaders can read it from the watcher thread.
+static set<string> referenced_bullet_patterns;
+
+
+// Every target layer list the bullet patterns have contained, which projectiles point to, so they stay valid when the
+// bullet patterns are reloaded.
+static set<vector<string>> target_layer_lists;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Curves can be given as a single value or as an object with a start and end value, and for rates the number of volleys
+// to ramp over.
+static Bullet_Pattern_Curve load_curve(const JSON & pattern_data, const string & key, float default_value)
+{
+    const auto curve_data = pattern_data.find(key);
+
+    if (curve_data == pattern_data.end())
+    {
+        return { default_value, default_value, 0 };
+    }
+
+    if (curve_data->is_number())
+    {
+        return { *curve_data, *curve_data, 0 };
+    }
+
+    return { curve_data->at("start"), curve_data->at("end"), curve_data->value("volleys", 0) };
+}
+
+
+static float get_curve_value(const Bullet_Pattern_Curve & curve, float progress)
+{
+    return curve.start + ((curve.end - curve.start) * progress);
+}
+
+
+static void load_referenced_bullet_patterns()
+{
+    const JSON & blueprints_data = get_blueprints_data();
+    referenced_bullet_patterns.insert(CODE_BULLET_PATTERNS.begin(), CODE_BULLET_PATTERNS.end());
+
+    for (const JSON & blueprint_data : blueprints_data)
+    {
+        const JSON & components_data = blueprint_data.value("components", JSON::object());
+
+        for (const JSON & component_data : components_data)
+        {
+            const auto bullet_pattern_data = component_data.find("bullet_pattern");
+
+            if (component_data.is_object() && bullet_pattern_data != component_data.end())
+            {
+                referenced_bullet_patterns.insert(bullet_pattern_data->get<string>());
+            }
+        }
+    }
+}
+
+
+static Bullet_Pattern load_bullet_pattern(const string & name, const JSON & pattern_data)
+{
+    static const map<string, Bullet_Pattern_Shapes> SHAPE_NAMES
+    {
+        { "aimed"  , Bullet_Pattern_Shapes::AIMED  },
+        { "spread" , Bullet_Pattern_Shapes::SPREAD },
+        { "ring"   , Bullet_Pattern_Shapes::RING   },
+        { "spiral" , Bullet_Pattern_Shapes::SPIRAL },
+    };
+
+    const string & shape_name = pattern_data.at("shape");
+    const string & projectile = pattern_data.at("projectile");
+    const JSON & origin_offset_data = pattern_data.value("origin_offset", JSON::object());
+    const JSON & blueprints_data = get_blueprints_data();
+    Bullet_Pattern bullet_pattern;
+
+    if (!contains_key(SHAPE_NAMES, shape_name))
+    {
+        throw runtime_error("ERROR: \"" + shape_name + "\" is not a valid shape for bullet pattern \"" + name + "\"!");
+    }
+
+    if (blueprints_data.find(projectile) == blueprints_data.end())
+    {
+        throw runtime_error(
+            "ERROR: bullet pattern \"" + name + "\" fires \"" + projectile + "\", which is not a blueprint!");
+    }
+
+
+    // Target layers are interned when the bullet patterns are swapped in.
+    bullet_pattern.volley =
+    {
+        projectile,
+        nullptr,
+        pattern_data.value("duration", 1.0f),
+        pattern_data.value("damage_modifier", 1.0f),
+    };
+
+    bullet_pattern.shape = SHAPE_NAMES.at(shape_name);
+    bullet_pattern.count = pattern_data.value("count", 1);
+    bullet_pattern.angle = pattern_data.value("angle", 0.0f);
+    bullet_pattern.spin = pattern_data.value("spin", 0.0f);
+    bullet_pattern.aim_snap = pattern_data.value("aim_snap", 0.0f);
+    bullet_pattern.origin_offset = vec2(origin_offset_data.value("x", 0.0f), origin_offset_data.value("y", 0.0f));
+    bullet_pattern.speed = load_curve(pattern_data, "speed", 1.0f);
+    bullet_pattern.rate = load_curve(pattern_data, "rate", 0.0f);
+
+    if (bullet_pattern.count < 1)
+    {
+        throw runtime_error("ERROR: bullet pattern \"" + name + "\" must fire at least 1 bullet per volley!");
+    }
+
+    if (bullet_pattern.rate.start < 0.0f || bullet_pattern.rate.end < 0.0f)
+    {
+        throw runtime_error("ERROR: bullet pattern \"" + name + "\" can't have a negative rate!");
+    }
+
+    return bullet_pattern;
+}
+
+
+// Builds the bullet patterns off the main thread, only interning their target layers once they're swapped in.
+static function<void()> load_bullet_patterns(const JSON & bullet_patterns_data)
+{
+    map<string, Bullet_Pattern> loaded_bullet_patterns;
+    map<string, vector<string>> loaded_target_layers;
+
+    for (
+        auto bullet_pattern_data = bullet_patterns_data.begin();
+        bullet_pattern_data != bullet_patterns_data.end();
+        bullet_pattern_data++)
+    {
+        const string & name = bullet_pattern_data.key();
+        loaded_bullet_patterns[name] = load_bullet_pattern(name, bullet_pattern_data.value());
+        loaded_target_layers[name] = bullet_pattern_data.value().at("target_layers").get<vector<string>>();
+    }
+
+
+    // Patterns are fired by name, so dropping or renaming one the game fires would fail mid-game.
+    for (const string & referenced_bullet_pattern : referenced_bullet_patterns)
+    {
+        if (!contains_key(loaded_bullet_patterns, referenced_bullet_pattern))
+        {
+            throw runtime_error(
+                "ERROR: bullet pattern \"" + referenced_bullet_pattern + "\" is fired by the game but not defined!");
+        }
+    }
+
+    return [=]() -> void
+    {
+        bullet_patterns = loaded_bullet_patterns;
+
+        for (auto & bullet_pattern : bullet_patterns)
+        {
+            bullet_pattern.second.volley.target_layers =
+                &*target_layer_lists.insert(loaded_target_layers.at(bullet_pattern.first)).first;
+        }
+    };
+}
+
+
+// Finds the angle in degrees of each bullet in a volley relative to the aim direction.
+static float get_bullet_angle(const Bullet_Pattern & bullet_pattern, int volley, int bullet)
+{
+    const int count = bullet_pattern.count;
+    const Bullet_Pattern_Shapes shape = bullet_pattern.shape;
+
+    return
+        shape == Bullet_Pattern_Shapes::SPREAD ? (bullet - ((count - 1) / 2.0f)) * bullet_pattern.angle :
+        shape == Bullet_Pattern_Shapes::RING ? bullet * (360.0f / count) :
+        shape == Bullet_Pattern_Shapes::SPIRAL ? (bullet * (360.0f / count)) + (volley * bullet_pattern.spin) :
+        0.0f;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void bullet_patterns_api_init()
+{
+    load_referenced_bullet_patterns();
+    load_data_file("resources/data/bullet_patterns.json", load_bullet_patterns);
+}
+
+
+// Fires the emitter's next volley of a bullet pattern as a single batch, returning false instead if the emitter's
+// cooldown from its last volley hasn't passed yet.
+bool emit_bullet_pattern(
+    const string & pattern_name,
+    Bullet_Emitter & emitter,
+    const vec3 & origin,
+    const vec3 & aim_direction)
+{
+    if (is_timer_pending(emitter.cooldown))
+    {
+        return false;
+    }
+
+    if (!contains_key(bullet_patterns, pattern_name))
+    {
+        throw runtime_error("ERROR: \"" + pattern_name + "\" is not a bullet pattern!");
+    }
+
+    const Bullet_Pattern & bullet_pattern = bullet_patterns.at(pattern_name);
+    const int count = bullet_pattern.count;
+    const int volley = emitter.volley;
+    float aim_angle = degrees(atan2(aim_direction.y, aim_direction.x));
+
+    if (bullet_pattern.aim_snap > 0.0f)
+    {
+        aim_angle = round(aim_angle / bullet_pattern.aim_snap) * bullet_pattern.aim_snap;
+    }
+
+
+    // Spawns only live until the volley is spawned, so they're kept in the frame arena.
+    Frame_Arena_Scope frame_arena_scope;
+    Frame_Vector<Projectile_Spawn> spawns(count);
+
+    for (int i = 0; i < count; i++)
+    {
+        const float angle = radians(aim_angle + get_bullet_angle(bullet_pattern, volley, i));
+        const vec3 direction(cos(angle), sin(angle), 0.0f);
+        Projectile_Spawn & spawn = spawns[i];
+        spawn.origin = origin + (direction * vec3(bullet_pattern.origin_offset, 0.0f));
+        spawn.direction = direction;
+        spawn.speed_modifier = get_curve_value(bullet_pattern.speed, count > 1 ? (float)i / (count - 1) : 0.0f);
+    }
+
+    projectile_spawn_volley(bullet_pattern.volley, spawns.data(), count);
+    emitter.volley++;
+
+
+    // Patterns without a rate leave their emitters' timing to whoever fires them.
+    const Bullet_Pattern_Curve & rate_curve = bullet_pattern.rate;
+
+    const float rate = get_curve_value(
+        rate_curve,
+        rate_curve.volleys > 0 ? min((float)volley / rate_curve.volleys, 1.0f) : 0.0f);
+
+    if (rate > 0.0f)
+    {
+        emitter.cooldown = schedule_timer(1.0f / rate);
+    }
+
+    return true;
+}
+
+
+} // namespace Game
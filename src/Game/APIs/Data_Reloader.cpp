@@ -0,0 +1,224 @@
+#include "Game/APIs/Data_Reloader.hpp"
+
+#include <map>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <stdexcept>
+#include <cstdio>
+#include "Cpp_Utils/Map.hpp"
+#include "Cpp_Utils/Collection.hpp"
+
+#ifdef __linux__
+    #include <unistd.h>
+    #include <poll.h>
+    #include <sys/inotify.h>
+#endif
+
+
+using std::map;
+using std::string;
+using std::function;
+using std::thread;
+using std::mutex;
+using std::lock_guard;
+using std::atomic;
+using std::exception;
+using std::runtime_error;
+
+// Cpp_Utils/JSON.hpp
+using Cpp_Utils::JSON;
+using Cpp_Utils::read_json_file;
+
+// Cpp_Utils/Map.hpp
+using Cpp_Utils::contains_key;
+
+// Cpp_Utils/Collection.hpp
+using Cpp_Utils::for_each;
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const string DATA_DIRECTORY("resources/data");
+static const string BLUEPRINTS_PATH(DATA_DIRECTORY + "/blueprints.json");
+static const int WATCH_POLL_TIMEOUT = 250;
+static map<string, Data_File_Loader> data_file_loaders;
+static map<string, function<void()>> pending_data_swaps;
+static mutex data_file_loaders_mutex;
+static mutex pending_data_swaps_mutex;
+static thread watcher_thread;
+static atomic<bool> watching(false);
+static int watcher_descriptor = -1;
+static JSON blueprints_data;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static bool get_data_file_loader(const string & path, Data_File_Loader & loader)
+{
+    lock_guard<mutex> lock(data_file_loaders_mutex);
+
+    if (!contains_key(data_file_loaders, path))
+    {
+        return false;
+    }
+
+    loader = data_file_loaders.at(path);
+    return true;
+}
+
+
+static void reload_data_file(const string & path)
+{
+    Data_File_Loader loader;
+
+    if (!get_data_file_loader(path, loader))
+    {
+        return;
+    }
+
+
+    // Invalid data, including files read while still being written, is reported and skipped so the current data stays
+    // in use until the file is saved again.
+    try
+    {
+        const function<void()> swap_data = loader(read_json_file(path));
+        lock_guard<mutex> lock(pending_data_swaps_mutex);
+        pending_data_swaps[path] = swap_data;
+    }
+    catch (const exception & error)
+    {
+        fprintf(stderr, "failed to reload \"%s\": %s\n", path.c_str(), error.what());
+    }
+}
+
+
+#ifdef __linux__
+static void watch_data_files()
+{
+    // Large enough to read several events at once, as each event's name is at most NAME_MAX + 1 bytes.
+    alignas(inotify_event) char events[4096];
+    pollfd watcher_poll_descriptor { watcher_descriptor, POLLIN, 0 };
+
+    while (watching)
+    {
+        if (poll(&watcher_poll_descriptor, 1, WATCH_POLL_TIMEOUT) <= 0)
+        {
+            continue;
+        }
+
+        const ssize_t events_size = read(watcher_descriptor, events, sizeof(events));
+        ssize_t event_offset = 0;
+
+        while (event_offset < events_size)
+        {
+            const inotify_event * event = (const inotify_event *)(events + event_offset);
+
+            if (event->len > 0)
+            {
+                reload_data_file(DATA_DIRECTORY + "/" + event->name);
+            }
+
+            event_offset += sizeof(inotify_event) + event->len;
+        }
+    }
+}
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void data_reloader_api_init()
+{
+    // Read before the watcher thread starts, so loaders it calls see the blueprints without locking.
+    blueprints_data = read_json_file(BLUEPRINTS_PATH);
+
+#ifdef __linux__
+    watcher_descriptor = inotify_init1(IN_NONBLOCK);
+
+    if (watcher_descriptor == -1)
+    {
+        throw runtime_error("ERROR: failed to initialize data file watcher!");
+    }
+
+
+    // Editors often save by renaming a temporary file over the original, so renamed files are reloaded along with
+    // written ones.
+    if (inotify_add_watch(watcher_descriptor, DATA_DIRECTORY.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) == -1)
+    {
+        throw runtime_error("ERROR: failed to watch \"" + DATA_DIRECTORY + "\" for changes!");
+    }
+
+    watching = true;
+    watcher_thread = thread(watch_data_files);
+#endif
+}
+
+
+void data_reloader_api_shutdown()
+{
+#ifdef __linux__
+    watching = false;
+
+    if (watcher_thread.joinable())
+    {
+        watcher_thread.join();
+    }
+
+    if (watcher_descriptor != -1)
+    {
+        close(watcher_descriptor);
+        watcher_descriptor = -1;
+    }
+#endif
+}
+
+
+void data_reloader_update()
+{
+    map<string, function<void()>> data_swaps;
+
+
+    // Take the pending swaps while locked, but apply them unlocked so the watcher thread is never blocked on them.
+    {
+        lock_guard<mutex> lock(pending_data_swaps_mutex);
+        data_swaps.swap(pending_data_swaps);
+    }
+
+    for_each(data_swaps, [](const string & /*path*/, const function<void()> & swap_data) -> void
+    {
+        swap_data();
+    });
+}
+
+
+void load_data_file(const string & path, const Data_File_Loader & loader)
+{
+    loader(read_json_file(path))();
+    lock_guard<mutex> lock(data_file_loaders_mutex);
+    data_file_loaders[path] = loader;
+}
+
+
+const JSON & get_blueprints_data()
+{
+    return blueprints_data;
+}
+
+
+} // namespace Game
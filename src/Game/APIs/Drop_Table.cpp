@@ -0,0 +1,268 @@
+#include "Game/APIs/Drop_Table.hpp"
+
+#include <map>
+#include <set>
+#include <vector>
+#include <string>
+#include <functional>
+#include <stdexcept>
+#include "Cpp_Utils/JSON.hpp"
+#include "Cpp_Utils/Map.hpp"
+
+#include "Game/Utilities.hpp"
+#include "Game/APIs/Data_Reloader.hpp"
+
+
+using std::map;
+using std::set;
+using std::vector;
+using std::string;
+using std::function;
+using std::runtime_error;
+
+// Cpp_Utils/JSON.hpp
+using Cpp_Utils::JSON;
+
+// Cpp_Utils/Map.hpp
+using Cpp_Utils::contains_key;
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct Drop_Table
+{
+    vector<const string *> item_names;
+    vector<float> item_probabilities;
+    vector<int> item_aliases;
+    float enemy_drop_chances[(int)Enemies::NONE];
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const string ITEM_BLUEPRINT("item");
+static Drop_Table drop_table;
+
+
+// Every item name the drop table has contained, which items keep pointers to, so they stay valid when the drop table is
+// reloaded.
+static set<string> item_names;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Builds the tables for Vose's alias method: each item gets a column holding its own probability and an alias item
+// filling the rest of the column, so sampling is one column pick and one coin flip no matter how skewed the weights
+// are.
+static void build_alias_tables(
+    const vector<float> & weights,
+    vector<float> & item_probabilities,
+    vector<int> & item_aliases)
+{
+    const int item_count = weights.size();
+    float total_weight = 0.0f;
+    vector<float> scaled_weights(item_count);
+    vector<int> small_items;
+    vector<int> large_items;
+    item_probabilities.assign(item_count, 1.0f);
+    item_aliases.assign(item_count, 0);
+
+    for (const float weight : weights)
+    {
+        if (weight <= 0.0f)
+        {
+            throw runtime_error("ERROR: item drop weights must be greater than 0!");
+        }
+
+        total_weight += weight;
+    }
+
+    for (int i = 0; i < item_count; i++)
+    {
+        scaled_weights[i] = (weights[i] * item_count) / total_weight;
+        (scaled_weights[i] < 1.0f ? small_items : large_items).push_back(i);
+    }
+
+
+    // Pair each under-full column with an over-full item that tops it up, moving the over-full item to the small list
+    // once it drops below 1.
+    while (!small_items.empty() && !large_items.empty())
+    {
+        const int small_item = small_items.back();
+        const int large_item = large_items.back();
+        small_items.pop_back();
+        large_items.pop_back();
+        item_probabilities[small_item] = scaled_weights[small_item];
+        item_aliases[small_item] = large_item;
+        scaled_weights[large_item] = (scaled_weights[large_item] + scaled_weights[small_item]) - 1.0f;
+        (scaled_weights[large_item] < 1.0f ? small_items : large_items).push_back(large_item);
+    }
+
+
+    // Whatever is left is only short of 1 due to floating point error, so it keeps its whole column.
+    for (const int item : small_items)
+    {
+        item_probabilities[item] = 1.0f;
+    }
+
+    for (const int item : large_items)
+    {
+        item_probabilities[item] = 1.0f;
+    }
+}
+
+
+// Builds the drop table off the main thread, only interning its item names once it's swapped in.
+// Items are spawned from the blueprint named after them, which must inherit the item blueprint directly or through its
+// parents.
+static bool is_item_blueprint(const JSON & blueprints_data, const string & name)
+{
+    const auto blueprint_data = blueprints_data.find(name);
+
+    if (blueprint_data == blueprints_data.end())
+    {
+        return false;
+    }
+
+    if (name == ITEM_BLUEPRINT)
+    {
+        return true;
+    }
+
+    for (const string & parent : blueprint_data->value("inherits", vector<string>()))
+    {
+        if (is_item_blueprint(blueprints_data, parent))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+static function<void()> load_drop_table(const JSON & drop_table_data)
+{
+    static const map<string, Enemies> ENEMY_NAMES
+    {
+        { "turret"        , Enemies::TURRET        },
+        { "tile_turret"   , Enemies::TILE_TURRET   },
+        { "wall_launcher" , Enemies::WALL_LAUNCHER },
+        { "boss"          , Enemies::BOSS          },
+    };
+
+    const JSON & item_weights_data = drop_table_data.at("items");
+    const JSON & enemy_drop_chances_data = drop_table_data.at("enemy_drop_chances");
+    Drop_Table loaded_drop_table;
+    vector<string> loaded_item_names;
+    vector<float> item_weights;
+
+    for (
+        auto item_weight_data = item_weights_data.begin();
+        item_weight_data != item_weights_data.end();
+        item_weight_data++)
+    {
+        const string & item_name = item_weight_data.key();
+
+        if (!is_item_blueprint(get_blueprints_data(), item_name))
+        {
+            throw runtime_error("ERROR: \"" + item_name + "\" in the item drop table is not an item blueprint!");
+        }
+
+        loaded_item_names.push_back(item_name);
+        item_weights.push_back(item_weight_data.value());
+    }
+
+    if (loaded_item_names.empty())
+    {
+        throw runtime_error("ERROR: item drop table has no items!");
+    }
+
+    build_alias_tables(item_weights, loaded_drop_table.item_probabilities, loaded_drop_table.item_aliases);
+
+    for (float & enemy_drop_chance : loaded_drop_table.enemy_drop_chances)
+    {
+        enemy_drop_chance = 0.0f;
+    }
+
+    for (
+        auto enemy_drop_chance_data = enemy_drop_chances_data.begin();
+        enemy_drop_chance_data != enemy_drop_chances_data.end();
+        enemy_drop_chance_data++)
+    {
+        const string & enemy_name = enemy_drop_chance_data.key();
+
+        if (!contains_key(ENEMY_NAMES, enemy_name))
+        {
+            throw runtime_error("ERROR: \"" + enemy_name + "\" is not a valid enemy for an item drop chance!");
+        }
+
+        loaded_drop_table.enemy_drop_chances[(int)ENEMY_NAMES.at(enemy_name)] = enemy_drop_chance_data.value();
+    }
+
+    return [=]() -> void
+    {
+        drop_table = loaded_drop_table;
+        drop_table.item_names.clear();
+
+        for (const string & item_name : loaded_item_names)
+        {
+            drop_table.item_names.push_back(&*item_names.insert(item_name).first);
+        }
+    };
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void drop_table_api_init()
+{
+    load_data_file("resources/data/item_spawn_ratios.json", load_drop_table);
+}
+
+
+const string * sample_item_drop(Enemies enemy)
+{
+    if (random(0.0f, 1.0f) >= drop_table.enemy_drop_chances[(int)enemy])
+    {
+        return nullptr;
+    }
+
+    const int column = random(0, drop_table.item_names.size());
+
+    return drop_table.item_names[
+        random(0.0f, 1.0f) < drop_table.item_probabilities[column] ? column : drop_table.item_aliases[column]];
+}
+
+
+const string * get_droppable_item_name(const string & name)
+{
+    for (const string * item_name : drop_table.item_names)
+    {
+        if (*item_name == name)
+        {
+            return item_name;
+        }
+    }
+
+    return nullptr;
+}
+
+
+} // namespace Game
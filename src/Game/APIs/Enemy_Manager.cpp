@@ -3,38 +3,56 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <glm/glm.hpp>
 #include "Nito/Components.hpp"
 #include "Nito/APIs/ECS.hpp"
 #include "Nito/APIs/Scene.hpp"
 #include "Cpp_Utils/Map.hpp"
+#include "Cpp_Utils/Vector.hpp"
+#include "Cpp_Utils/Collection.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Utilities.hpp"
+#include "Game/World.hpp"
 #include "Game/Components.hpp"
 #include "Game/APIs/Floor_Manager.hpp"
+#include "Game/APIs/Frame_Arena.hpp"
 #include "Game/Systems/Game_Manager.hpp"
 #include "Game/Systems/Boss.hpp"
 #include "Game/Systems/Turret.hpp"
 #include "Game/Systems/Tile_Turret.hpp"
 #include "Game/Systems/Wall_Launcher.hpp"
+#include "Game/Systems/Item.hpp"
 
 
 using std::string;
 using std::vector;
 using std::map;
 
+// glm/glm.hpp
+using glm::ivec2;
+
 // Nito/Components.hpp
+using Nito::Transform;
 using Nito::Sprite;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
 using Nito::get_entity;
-using Nito::get_component;
+using Nito::flag_entity_for_deletion;
 
 // Nito/APIs/Scene.hpp
 using Nito::load_blueprint;
 
 // Cpp_Utils/Map.hpp
 using Cpp_Utils::contains_key;
+using Cpp_Utils::remove;
+
+// Cpp_Utils/Vector.hpp
+using Cpp_Utils::contains;
+
+// Cpp_Utils/Collection.hpp
+using Cpp_Utils::for_each;
 
 
 namespace Game
@@ -46,17 +64,8 @@ namespace Game
 // Data Structures
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-enum class Enemies
-{
-    TURRET,
-    TILE_TURRET,
-    WALL_LAUNCHER,
-    NONE,
-};
-
-
-using Enemy_Generator = vector<Entity>(*)(int, int, int);
-using Boss_Generator = Entity(*)(int, int);
+using Enemy_Generator = vector<Entity>(*)(int, int, int, int);
+using Boss_Generator = Entity(*)(int, int, int);
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -72,22 +81,42 @@ static const string ROOM_CHANGE_HANDLER_ID("enemy_manager");
 // Utilities
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static void track_enemy(Entity enemy_entity, int room)
+static void spawn_boss(int room, int room_origin_x, int room_origin_y)
 {
-    ((Health *)get_component(enemy_entity, "health"))->death_handlers["enemy_manager enemy death"] = [=]() -> void
+    static const vector<string> BOSS_IDS
     {
-        // Remove enemy from its associated room's enemy count.
-        remove_enemy(room, enemy_entity);
+        "boss",
+    };
 
-        game_manager_untrack_render_flag(room, enemy_entity);
-        game_manager_untrack_collider_enabled_flag(room, enemy_entity);
-        game_manager_untrack_enemy_enabled_flag(room, enemy_entity);
+    static const map<string, Boss_Generator> BOSS_GENERATORS
+    {
+        { "boss", boss_generate },
     };
 
-    add_enemy(room, enemy_entity);
-    game_manager_track_render_flag(room, enemy_entity);
-    game_manager_track_collider_enabled_flag(room, enemy_entity);
-    game_manager_track_enemy_enabled_flag(room, enemy_entity);
+    const string & boss_id = BOSS_IDS[random(0, BOSS_IDS.size())];
+    const Entity boss = BOSS_GENERATORS.at(boss_id)(room, room_origin_x, room_origin_y);
+    track_enemy(boss, Enemies::BOSS, room);
+
+    bool * boss_health_bar_backround_render =
+        &component<Sprite>(get_entity("boss_health_bar_background"))->render;
+
+    game_manager_add_room_change_handler(ROOM_CHANGE_HANDLER_ID, [=](int /*room_a*/, int room_b) -> void
+    {
+        if (room_b == room)
+        {
+            load_blueprint("boss_health_bar");
+            *boss_health_bar_backround_render = true;
+        }
+    });
+
+    component<Health>(boss)->death_handlers["enemy_manager boss death"] = [=]() -> void
+    {
+        *boss_health_bar_backround_render = false;
+
+
+        // Prevent loading health bar when entering boss room after boss has already died.
+        game_manager_remove_room_change_handler(ROOM_CHANGE_HANDLER_ID);
+    };
 }
 
 
@@ -98,123 +127,204 @@ static void track_enemy(Entity enemy_entity, int room)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void generate_enemies()
 {
-    const int room_tile_width = get_room_tile_width();
-    const int room_tile_height = get_room_tile_height();
+    generate_enemy_groups();
+    spawn_enemies();
+}
+
+
+void generate_enemy_groups()
+{
+    static const vector<Enemies> POSSIBLE_ENEMIES
+    {
+        Enemies::TURRET,
+        Enemies::TILE_TURRET,
+        Enemies::WALL_LAUNCHER,
+    };
+
     const int boss_room = get_max_room_id();
-    int boss_room_origin_x = 0;
-    int boss_room_origin_y = 0;
-    map<int, vector<Enemies>> room_enemy_groups;
+    const int turret_layout_count = get_turret_layout_count();
+    Enemy_Groups & enemy_groups = get_world().enemy_groups;
+    enemy_groups.clear();
 
-    iterate_rooms([&](int x, int y, int & room) -> void
+    iterate_rooms([&](int /*x*/, int /*y*/, int & room) -> void
     {
-        static const vector<Enemies> POSSIBLE_ENEMIES
+        // Don't generate enemies for non-rooms or spawn room.
+        if (room == 0 || room == get_spawn_room_id())
         {
-            Enemies::TURRET,
-            Enemies::TILE_TURRET,
-            Enemies::WALL_LAUNCHER,
-        };
+            return;
+        }
 
 
-        // Don't generate enemies for non-rooms or spawn room.
-        if (room == 0 || room == 1)
+        // Each room shares one enemy group, but every room tile section gets its own enemy layout.
+        if (contains_key(enemy_groups, room))
         {
+            enemy_groups[room].layouts.push_back(random(0, turret_layout_count));
             return;
         }
 
 
-        // Don't generate enemies for boss room, but store its origin coordinates for boss generation.
+        Enemy_Group & enemy_group = enemy_groups[room];
+        vector<Enemies> & enemies = enemy_group.enemies;
+        enemy_group.layouts.push_back(random(0, turret_layout_count));
+
+
+        // Boss room only contains the boss.
         if (room == boss_room)
         {
-            boss_room_origin_x = room_tile_width * x;
-            boss_room_origin_y = room_tile_height * y;
+            enemies.push_back(Enemies::BOSS);
             return;
         }
 
 
-        if (!contains_key(room_enemy_groups, room))
+        for (const Enemies enemy : POSSIBLE_ENEMIES)
         {
-            vector<Enemies> & enemy_group = room_enemy_groups[room];
-
-            for (const Enemies enemy : POSSIBLE_ENEMIES)
+            if (random(0, 2) == 1)
             {
-                if (random(0, 2) == 1)
-                {
-                    enemy_group.push_back(enemy);
-                }
+                enemies.push_back(enemy);
             }
+        }
+
 
+        // Rooms get harder the farther they are from spawn, needing more of the possible enemies the deeper they are,
+        // but each enemy group has atleast 1 enemy.
+        const int min_enemy_count =
+            1 + ((get_room_depth(room) * ((int)POSSIBLE_ENEMIES.size() - 1)) / get_max_room_depth());
 
-            // Ensure each enemy group has atleast 1 enemy.
-            if (enemy_group.size() == 0)
+        while ((int)enemies.size() < min_enemy_count)
+        {
+            const Enemies enemy = POSSIBLE_ENEMIES[random(0, POSSIBLE_ENEMIES.size())];
+
+            if (!contains(enemies, enemy))
             {
-                enemy_group.push_back(POSSIBLE_ENEMIES[random(0, POSSIBLE_ENEMIES.size())]);
+                enemies.push_back(enemy);
             }
         }
     });
+}
 
 
-    // Use enemy data to generate enemy entities.
-    iterate_rooms([&](int x, int y, int & room) -> void
+void spawn_enemies()
+{
+    // Only built rooms get their enemies, as streamed rooms spawn theirs when they are built.
+    for_each(get_world().enemy_groups, [](int room, const Enemy_Group & /*enemy_group*/) -> void
     {
-        static const map<Enemies, Enemy_Generator> ENEMY_GENERATORS
+        if (is_room_built(room))
         {
-            { Enemies::TURRET        , turret_generate        },
-            { Enemies::TILE_TURRET   , tile_turret_generate   },
-            { Enemies::WALL_LAUNCHER , wall_launcher_generate },
-        };
+            spawn_room_enemies(room);
+        }
+    });
+}
+
 
-        for (const Enemies enemy : room_enemy_groups[room])
+void spawn_room_enemies(int room)
+{
+    static const map<Enemies, Enemy_Generator> ENEMY_GENERATORS
+    {
+        { Enemies::TURRET        , turret_generate        },
+        { Enemies::TILE_TURRET   , tile_turret_generate   },
+        { Enemies::WALL_LAUNCHER , wall_launcher_generate },
+    };
+
+    const Enemy_Groups & enemy_groups = get_world().enemy_groups;
+
+
+    // Rooms without an enemy group have no enemies or have already been cleared.
+    if (!contains_key(enemy_groups, room))
+    {
+        return;
+    }
+
+    const int room_tile_width = get_room_tile_width();
+    const int room_tile_height = get_room_tile_height();
+    const Enemy_Group & enemy_group = enemy_groups.at(room);
+    int layout_index = 0;
+
+
+    // Use enemy data to generate enemy entities for each of the room's sections.
+    for (const ivec2 & room_section : get_room_sections(room))
+    {
+        const int layout = enemy_group.layouts[layout_index++];
+
+        for (const Enemies enemy : enemy_group.enemies)
         {
+            if (enemy == Enemies::BOSS)
+            {
+                spawn_boss(room, room_tile_width * room_section.x, room_tile_height * room_section.y);
+                continue;
+            }
+
+
             const vector<Entity> generated_enemies = ENEMY_GENERATORS.at(enemy)(
                 room,
-                x * room_tile_width,
-                y * room_tile_height);
+                room_section.x * room_tile_width,
+                room_section.y * room_tile_height,
+                layout);
 
 
             // Track enemies generated for this room.
             for (const Entity enemy_entity : generated_enemies)
             {
-                track_enemy(enemy_entity, room);
+                track_enemy(enemy_entity, enemy, room);
             }
         }
-    });
+    }
+}
 
 
-    // Generate boss.
-    static const vector<string> BOSS_IDS
-    {
-        "boss",
-    };
+void release_room_enemies(int room)
+{
+    // Released enemies are destroyed without dying, so their room keeps its enemy group and respawns them when it is
+    // built again.
+    const vector<Entity> & tracked_room_enemies = get_room_enemies(room);
+    const Frame_Vector<Entity> room_enemies(tracked_room_enemies.begin(), tracked_room_enemies.end());
 
-    static const map<string, Boss_Generator> BOSS_GENERATORS
+    for (const Entity enemy_entity : room_enemies)
     {
-        { "boss", boss_generate },
-    };
-
-    const string & boss_id = BOSS_IDS[random(0, BOSS_IDS.size())];
-    const Entity boss = BOSS_GENERATORS.at(boss_id)(boss_room_origin_x, boss_room_origin_y);
-    track_enemy(boss, boss_room);
+        remove_enemy(room, enemy_entity);
+        game_manager_untrack_render_flag(room, enemy_entity);
+        game_manager_untrack_collider_enabled_flag(room, enemy_entity);
+        game_manager_untrack_enemy_enabled_flag(room, enemy_entity);
+        flag_entity_for_deletion(enemy_entity);
+    }
+}
 
-    bool * boss_health_bar_backround_render =
-        &((Sprite *)get_component(get_entity("boss_health_bar_background"), "sprite"))->render;
 
-    game_manager_add_room_change_handler(ROOM_CHANGE_HANDLER_ID, [=](int /*room_a*/, int room_b) -> void
+void track_enemy(Entity enemy_entity, Enemies enemy, int room)
+{
+    component<Health>(enemy_entity)->death_handlers["enemy_manager enemy death"] = [=]() -> void
     {
-        if (room_b == boss_room)
+        check_spawn_item(enemy, room, component<Transform>(enemy_entity)->position);
+
+        // Remove enemy from its associated room's enemy count, and forget the room's enemy group once it has been
+        // cleared so it is never respawned.
+        remove_enemy(room, enemy_entity);
+
+        if (get_room_enemy_count(room) == 0)
         {
-            load_blueprint("boss_health_bar");
-            *boss_health_bar_backround_render = true;
+            remove(get_world().enemy_groups, room);
         }
-    });
 
-    ((Health *)get_component(boss, "health"))->death_handlers["enemy_manager boss death"] = [=]() -> void
-    {
-        *boss_health_bar_backround_render = false;
+        game_manager_untrack_render_flag(room, enemy_entity);
+        game_manager_untrack_collider_enabled_flag(room, enemy_entity);
+        game_manager_untrack_enemy_enabled_flag(room, enemy_entity);
+    };
 
+    add_enemy(room, enemy_entity);
+    game_manager_track_render_flag(room, enemy_entity);
+    game_manager_track_collider_enabled_flag(room, enemy_entity);
+    game_manager_track_enemy_enabled_flag(room, enemy_entity);
+}
 
-        // Prevent loading health bar when entering boss room after boss has already died.
-        game_manager_remove_room_change_handler(ROOM_CHANGE_HANDLER_ID);
-    };
+
+const Enemy_Groups & get_enemy_groups()
+{
+    return get_world().enemy_groups;
+}
+
+
+void set_enemy_groups(const Enemy_Groups & _enemy_groups)
+{
+    get_world().enemy_groups = _enemy_groups;
 }
 
 
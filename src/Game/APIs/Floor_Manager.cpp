@@ -3,6 +3,9 @@
 #include <vector>
 #include <map>
 #include <stdexcept>
+#include <cstdint>
+#include <algorithm>
+#include <climits>
 #include "Nito/Components.hpp"
 #include "Nito/Collider_Component.hpp"
 #include "Nito/APIs/Scene.hpp"
@@ -11,9 +14,14 @@
 #include "Cpp_Utils/Vector.hpp"
 #include "Cpp_Utils/Collection.hpp"
 #include "Cpp_Utils/JSON.hpp"
+#include "Cpp_Utils/String.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Utilities.hpp"
+#include "Game/World.hpp"
 #include "Game/Components.hpp"
+#include "Game/APIs/Data_Reloader.hpp"
+#include "Game/APIs/Frame_Arena.hpp"
 #include "Game/Systems/Game_Manager.hpp"
 #include "Game/Systems/Room_Exit_Handler.hpp"
 
@@ -23,22 +31,28 @@ using std::vector;
 using std::map;
 using std::function;
 using std::runtime_error;
+using std::copy;
+using std::max_element;
+using std::swap;
+using std::fill;
+using std::find;
 
 // glm/glm.hpp
 using glm::vec3;
 using glm::vec2;
 using glm::ivec2;
+using glm::min;
+using glm::max;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
-using Nito::has_component;
 
 // Nito/APIs/Scene.hpp
 using Nito::load_blueprint;
 
 // Nito/Components.hpp
 using Nito::Transform;
+using Nito::Light_Source;
 
 // Nito/Collider_Component.hpp
 using Nito::Collider;
@@ -60,8 +74,12 @@ using Cpp_Utils::remove;
 using Cpp_Utils::for_each;
 
 // Cpp_Utils/JSON.hpp
+using Cpp_Utils::JSON;
 using Cpp_Utils::read_json_file;
 
+// Cpp_Utils/String.hpp
+using Cpp_Utils::to_string;
+
 
 namespace Game
 {
@@ -72,16 +90,152 @@ namespace Game
 // Data Structures
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-using Possible_Rooms = map<int *, ivec2>;
+enum Room_Edges
+{
+    BOTTOM_EDGE,
+    LEFT_EDGE,
+    TOP_EDGE,
+    RIGHT_EDGE,
+    ROOM_EDGE_COUNT,
+};
 
 
-struct Floor
+// What lies past a room edge. An edge's mask is its neighbor state * 2, plus 1 if the room also continues past the
+// edge's corner (the clockwise neighbor), which is all a room's wall tiles depend on.
+enum Edge_Neighbors
 {
-    int size;
-    int room_tiles_width;
-    int * rooms;
-    Tile * room_tiles;
-    Possible_Rooms possible_rooms;
+    WALL_NEIGHBOR,
+    SAME_ROOM_NEIGHBOR,
+    DOOR_NEIGHBOR,
+    EDGE_NEIGHBOR_COUNT,
+};
+
+
+// Wall tiles for every position along each edge of a WIDTH * HEIGHT room section under every edge mask, built at
+// compile time so walls are stamped per edge instead of being worked out tile by tile. Each edge owns the corner at its
+// counter-clockwise end, so an edge covers its dimension's size - 1 tiles.
+template<int WIDTH, int HEIGHT>
+struct Wall_Tile_Table
+{
+    static constexpr int MAX_EDGE_LENGTH = (WIDTH > HEIGHT ? WIDTH : HEIGHT) - 1;
+    static constexpr int EDGE_MASK_COUNT = EDGE_NEIGHBOR_COUNT * 2;
+
+    Packed_Tile tiles[ROOM_EDGE_COUNT][EDGE_MASK_COUNT][MAX_EDGE_LENGTH];
+    int tile_indexes[ROOM_EDGE_COUNT][MAX_EDGE_LENGTH];
+    int edge_lengths[ROOM_EDGE_COUNT];
+
+    constexpr Wall_Tile_Table()
+        : tiles()
+        , tile_indexes()
+        , edge_lengths()
+    {
+        for (int edge = 0; edge < ROOM_EDGE_COUNT; edge++)
+        {
+            const bool inverted = is_inverted(edge);
+            const int dimension_size = get_dimension_size(edge);
+            edge_lengths[edge] = dimension_size - 1;
+
+            // Positions past a shorter edge's end are filled too, as every member must be written during constant
+            // evaluation, but they're never stamped.
+            for (int position = 0; position < MAX_EDGE_LENGTH; position++)
+            {
+                const bool on_edge = position < edge_lengths[edge];
+                const int coordinate = inverted ? position + 1 : position;
+                tile_indexes[edge][position] = on_edge ? get_tile_index(edge, coordinate) : 0;
+
+                for (int edge_mask = 0; edge_mask < EDGE_MASK_COUNT; edge_mask++)
+                {
+                    tiles[edge][edge_mask][position] =
+                        on_edge ? get_wall_tile(edge, edge_mask, coordinate) : Packed_Tile { 0, 0 };
+                }
+            }
+        }
+    }
+
+    static constexpr bool is_inverted(int edge)
+    {
+        return edge == LEFT_EDGE || edge == TOP_EDGE;
+    }
+
+    static constexpr int get_dimension_size(int edge)
+    {
+        return edge == BOTTOM_EDGE || edge == TOP_EDGE ? WIDTH : HEIGHT;
+    }
+
+    static constexpr int get_tile_index(int edge, int coordinate)
+    {
+        return
+            edge == BOTTOM_EDGE ? coordinate :
+            edge == LEFT_EDGE   ? coordinate * WIDTH :
+            edge == TOP_EDGE    ? ((HEIGHT - 1) * WIDTH) + coordinate :
+                                  (coordinate * WIDTH) + (WIDTH - 1);
+    }
+
+    static constexpr Packed_Tile get_wall_tile(int edge, int edge_mask, int coordinate)
+    {
+        // Bottom, left, top and right walls face 0, 270, 180 and 90 degrees.
+        const uint8_t quarter_turns = (4 - edge) % 4;
+        const bool inverted = is_inverted(edge);
+        const int dimension_size = get_dimension_size(edge);
+        const int neighbor = edge_mask / 2;
+        const bool clockwise_room = edge_mask % 2 == 1;
+
+        // Corner
+        if (coordinate == (inverted ? dimension_size - 1 : 0))
+        {
+            // Inner corner
+            if (neighbor == SAME_ROOM_NEIGHBOR && clockwise_room)
+            {
+                return { (uint8_t)Tile_Types::WALL_CORNER_INNER, quarter_turns };
+            }
+            // Wall to neighbor
+            else if (neighbor == SAME_ROOM_NEIGHBOR)
+            {
+                return { (uint8_t)Tile_Types::WALL, (uint8_t)((quarter_turns + 3) % 4) };
+            }
+            // Wall to clockwise neighbor
+            else if (clockwise_room)
+            {
+                return { (uint8_t)Tile_Types::WALL, quarter_turns };
+            }
+
+            // Outer corner
+            return { (uint8_t)Tile_Types::WALL_CORNER, quarter_turns };
+        }
+        // Floor between rooms
+        else if (neighbor == SAME_ROOM_NEIGHBOR)
+        {
+            return { (uint8_t)Tile_Types::FLOOR, 0 };
+        }
+        else if (neighbor == DOOR_NEIGHBOR)
+        {
+            // Door
+            if (coordinate == (dimension_size - 1) / 2)
+            {
+                return { (uint8_t)Tile_Types::DOOR, quarter_turns };
+            }
+            // Door-adjacent walls
+            else if (coordinate == (dimension_size - 2) / 2)
+            {
+                return
+                {
+                    (uint8_t)(inverted ? Tile_Types::LEFT_DOOR_WALL : Tile_Types::RIGHT_DOOR_WALL),
+                    quarter_turns,
+                };
+            }
+            else if (coordinate == ((dimension_size - 2) / 2) + 2)
+            {
+                return
+                {
+                    (uint8_t)(inverted ? Tile_Types::RIGHT_DOOR_WALL : Tile_Types::LEFT_DOOR_WALL),
+                    quarter_turns,
+                };
+            }
+        }
+
+        // Normal wall
+        return { (uint8_t)Tile_Types::WALL, quarter_turns };
+    }
 };
 
 
@@ -92,20 +246,54 @@ struct Floor
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static const int ROOM_TILE_WIDTH = 13;
 static const int ROOM_TILE_HEIGHT = 9;
+static const int ROOM_TILE_COUNT = ROOM_TILE_WIDTH * ROOM_TILE_HEIGHT;
 static const float ROOM_Z = 100.0f;
 static const int ROOM_TILE_TEXTURE_SIZE = 32;
 static const float ROOM_TILE_TEXTURE_ORIGINS = 0.5f;
 static const string ROOM_CHANGE_HANDLER_ID("floor_manager");
 static const int SPAWN_ROOM_ID = 1;
 static vec3 room_tile_unit_size;
-static Floor current_floor;
-static vec2 spawn_position;
-static map<int, Room_Data> room_datas;
-static map<int, vector<Entity>> room_enemies;
-static map<int, vector<Entity>> room_exits;
-static int max_room_id;
 static map<string, function<void()>> floor_generated_handlers;
-static vector<vector<int>> obstacle_layouts;
+static bool floor_streaming;
+
+
+// Obstacle layouts are packed at 2 bits per room tile into one contiguous array of words, with rows already flipped to
+// the bottom-to-top order room tiles are stored in. Packed values index OBSTACLE_LAYOUT_TILE_TYPES directly.
+static const Tile_Types OBSTACLE_LAYOUT_TILE_TYPES[]
+{
+    Tile_Types::FLOOR,
+    Tile_Types::FLOOR_LEDGE,
+    Tile_Types::FLOOR_HOLE,
+};
+
+static const int OBSTACLE_LAYOUT_TILE_TYPE_COUNT = sizeof(OBSTACLE_LAYOUT_TILE_TYPES) / sizeof(Tile_Types);
+static const int OBSTACLE_LAYOUT_TILE_BITS = 2;
+static const uint64_t OBSTACLE_LAYOUT_TILE_MASK = (1u << OBSTACLE_LAYOUT_TILE_BITS) - 1;
+static const int OBSTACLE_LAYOUT_TILES_PER_WORD = 64 / OBSTACLE_LAYOUT_TILE_BITS;
+static const int OBSTACLE_LAYOUT_TILE_COUNT = ROOM_TILE_COUNT;
+
+static const int OBSTACLE_LAYOUT_WORD_COUNT =
+    (OBSTACLE_LAYOUT_TILE_COUNT + OBSTACLE_LAYOUT_TILES_PER_WORD - 1) / OBSTACLE_LAYOUT_TILES_PER_WORD;
+
+static vector<uint64_t> obstacle_layouts;
+
+
+static constexpr Wall_Tile_Table<ROOM_TILE_WIDTH, ROOM_TILE_HEIGHT> WALL_TILE_TABLE {};
+
+
+// Offsets from a room section to the sections past each of its edges, and past each edge's corner.
+static const ivec2 ROOM_EDGE_NEIGHBOR_OFFSETS[ROOM_EDGE_COUNT] { { 0, -1 }, { -1, 0 }, { 0, 1 }, { 1, 0 } };
+static const ivec2 ROOM_EDGE_CLOCKWISE_NEIGHBOR_OFFSETS[ROOM_EDGE_COUNT] { { -1, 0 }, { 0, 1 }, { 1, 0 }, { 0, -1 } };
+
+
+// Where the door on each edge of a room section is, relative to the section.
+static const ivec2 ROOM_EDGE_DOOR_COORDINATES[ROOM_EDGE_COUNT]
+{
+    { (ROOM_TILE_WIDTH - 1) / 2 , 0                          },
+    { 0                         , (ROOM_TILE_HEIGHT - 1) / 2 },
+    { (ROOM_TILE_WIDTH - 1) / 2 , ROOM_TILE_HEIGHT - 1       },
+    { ROOM_TILE_WIDTH - 1       , (ROOM_TILE_HEIGHT - 1) / 2 },
+};
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -113,27 +301,87 @@ static vector<vector<int>> obstacle_layouts;
 // Utilities
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static int get_room_section_index(int room_x, int room_y)
+{
+    return (room_y * get_world().floor_manager.current_floor.size) + room_x;
+}
+
+
+// Room tiles are stored room-major, with each room section's tiles in one contiguous ROOM_TILE_WIDTH *
+// ROOM_TILE_HEIGHT block so per-room passes never stride across the floor.
+static int get_room_tile_index(int x, int y)
+{
+    return
+        (get_room_section_index(x / ROOM_TILE_WIDTH, y / ROOM_TILE_HEIGHT) * ROOM_TILE_COUNT) +
+        ((y % ROOM_TILE_HEIGHT) * ROOM_TILE_WIDTH) +
+        (x % ROOM_TILE_WIDTH);
+}
+
+
 static void iterate_room_tiles(
     int room_x,
     int room_y,
     bool relative_coordinates,
-    const function<void(int, int, Tile &)> & callback)
+    const function<void(int, int, Packed_Tile &)> & callback)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    Packed_Tile * room_section_tiles =
+        &floor_state.current_floor.room_tiles[get_room_section_index(room_x, room_y) * ROOM_TILE_COUNT];
+
+    const int origin_x = relative_coordinates ? 0 : room_x * ROOM_TILE_WIDTH;
+    const int origin_y = relative_coordinates ? 0 : room_y * ROOM_TILE_HEIGHT;
+
+    for (int y = 0; y < ROOM_TILE_HEIGHT; y++)
+    {
+        for (int x = 0; x < ROOM_TILE_WIDTH; x++)
+        {
+            callback(origin_x + x, origin_y + y, room_section_tiles[(y * ROOM_TILE_WIDTH) + x]);
+        }
+    }
+}
+
+
+// Rotations are always multiples of 90 degrees, so they're packed as quarter turns; -90 is packed the same as 270.
+static Packed_Tile pack_tile(Tile_Types type, float rotation)
 {
-    iterate_array_2d(
-        current_floor.room_tiles,
-        current_floor.size * ROOM_TILE_WIDTH,
-        room_x * ROOM_TILE_WIDTH,
-        room_y * ROOM_TILE_HEIGHT,
-        ROOM_TILE_WIDTH,
-        ROOM_TILE_HEIGHT,
-        relative_coordinates,
-        callback);
+    const uint8_t quarter_turns = ((((int)(rotation / 90.0f)) % 4) + 4) % 4;
+    return { (uint8_t)type, quarter_turns };
+}
+
+
+static Tile unpack_tile(const Packed_Tile & packed_tile, int room)
+{
+    return
+    {
+        (Tile_Types)packed_tile.type,
+        (packed_tile.flags & PACKED_TILE_ROTATION_MASK) * 90.0f,
+        room,
+    };
+}
+
+
+static int get_room_edge_mask(int room_x, int room_y, int room, int edge)
+{
+    const ivec2 & neighbor_offset = ROOM_EDGE_NEIGHBOR_OFFSETS[edge];
+    const ivec2 & clockwise_neighbor_offset = ROOM_EDGE_CLOCKWISE_NEIGHBOR_OFFSETS[edge];
+    const int neighbor = get_room(room_x + neighbor_offset.x, room_y + neighbor_offset.y);
+
+    const int clockwise_neighbor =
+        get_room(room_x + clockwise_neighbor_offset.x, room_y + clockwise_neighbor_offset.y);
+
+    const int neighbor_state =
+        neighbor == room ? SAME_ROOM_NEIGHBOR :
+        neighbor > 0     ? DOOR_NEIGHBOR :
+                           WALL_NEIGHBOR;
+
+    return (neighbor_state * 2) + (clockwise_neighbor == room ? 1 : 0);
 }
 
 
 static void check_possible_room(Possible_Rooms & room_extensions, int x, int y)
 {
-    const int size = current_floor.size;
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    const int size = floor_state.current_floor.size;
 
     if (x < 0 || x >= size ||
         y < 0 || y >= size)
@@ -141,20 +389,21 @@ static void check_possible_room(Possible_Rooms & room_extensions, int x, int y)
         return;
     }
 
-    int * room = array_2d_at(current_floor.rooms, size, x, y);
+    int * room = array_2d_at(floor_state.current_floor.rooms, size, x, y);
 
     if (*room == 0 && !contains_key(room_extensions, room))
     {
         ivec2 room_coordinates(x, y);
         room_extensions[room] = room_coordinates;
-        current_floor.possible_rooms[room] = room_coordinates;
+        floor_state.current_floor.possible_rooms[room] = room_coordinates;
     }
 }
 
 
 static void set_room(Possible_Rooms & room_extensions, int x, int y, int id)
 {
-    int * room = array_2d_at(current_floor.rooms, current_floor.size, x, y);
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    int * room = array_2d_at(floor_state.current_floor.rooms, floor_state.current_floor.size, x, y);
     *room = id;
 
     if (contains_key(room_extensions, room))
@@ -162,9 +411,9 @@ static void set_room(Possible_Rooms & room_extensions, int x, int y, int id)
         remove(room_extensions, room);
     }
 
-    if (contains_key(current_floor.possible_rooms, room))
+    if (contains_key(floor_state.current_floor.possible_rooms, room))
     {
-        remove(current_floor.possible_rooms, room);
+        remove(floor_state.current_floor.possible_rooms, room);
     }
 
     check_possible_room(room_extensions, x + 1, y);
@@ -190,17 +439,123 @@ static vec2 get_room_center(int room_x, int room_y)
 
 static void set_room_locked(int room_id, bool locked)
 {
-    for (const Entity room_exit : room_exits.at(room_id))
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+    for (const Entity room_exit : floor_state.room_exits.at(room_id))
     {
-        room_exit_handler_set_locked(room_exit, locked);
+        // Only update exits that change, as unlocking an exit without a door lock is an error.
+        if (component<Room_Exit>(room_exit)->locked != locked)
+        {
+            room_exit_handler_set_locked(room_exit, locked);
+        }
     }
 }
 
 
+static vector<uint64_t> pack_obstacle_layouts(const vector<vector<int>> & unpacked_obstacle_layouts)
+{
+    if (unpacked_obstacle_layouts.size() == 0)
+    {
+        throw runtime_error("ERROR: there must be at least 1 obstacle layout!");
+    }
+
+    vector<uint64_t> packed_obstacle_layouts(unpacked_obstacle_layouts.size() * OBSTACLE_LAYOUT_WORD_COUNT, 0);
+
+    for (size_t layout = 0; layout < unpacked_obstacle_layouts.size(); layout++)
+    {
+        const vector<int> & unpacked_obstacle_layout = unpacked_obstacle_layouts[layout];
+        uint64_t * obstacle_layout = &packed_obstacle_layouts[layout * OBSTACLE_LAYOUT_WORD_COUNT];
+
+        if (unpacked_obstacle_layout.size() != OBSTACLE_LAYOUT_TILE_COUNT)
+        {
+            throw runtime_error(
+                "ERROR: obstacle layouts must have " + to_string(OBSTACLE_LAYOUT_TILE_COUNT) + " tiles!");
+        }
+
+        for (int y = 0; y < ROOM_TILE_HEIGHT; y++)
+        {
+            for (int x = 0; x < ROOM_TILE_WIDTH; x++)
+            {
+                // Obstacle layouts are written top row first.
+                const int obstacle = unpacked_obstacle_layout[((ROOM_TILE_HEIGHT - y - 1) * ROOM_TILE_WIDTH) + x];
+                const int tile_index = (y * ROOM_TILE_WIDTH) + x;
+
+                if (obstacle < 0 || obstacle >= OBSTACLE_LAYOUT_TILE_TYPE_COUNT)
+                {
+                    throw runtime_error("ERROR: " + to_string(obstacle) + " is not a valid obstacle layout tile!");
+                }
+
+                obstacle_layout[tile_index / OBSTACLE_LAYOUT_TILES_PER_WORD] |=
+                    (uint64_t)obstacle << ((tile_index % OBSTACLE_LAYOUT_TILES_PER_WORD) * OBSTACLE_LAYOUT_TILE_BITS);
+            }
+        }
+    }
+
+    return packed_obstacle_layouts;
+}
+
+
+static Tile_Types get_obstacle_layout_tile_type(const uint64_t * obstacle_layout, int tile_index)
+{
+    const uint64_t word = obstacle_layout[tile_index / OBSTACLE_LAYOUT_TILES_PER_WORD];
+    const int shift = (tile_index % OBSTACLE_LAYOUT_TILES_PER_WORD) * OBSTACLE_LAYOUT_TILE_BITS;
+    return OBSTACLE_LAYOUT_TILE_TYPES[(word >> shift) & OBSTACLE_LAYOUT_TILE_MASK];
+}
+
+
+static int get_obstacle_layout_count()
+{
+    return obstacle_layouts.size() / OBSTACLE_LAYOUT_WORD_COUNT;
+}
+
+
+static function<void()> load_obstacle_layouts(const JSON & obstacle_layouts_data)
+{
+    const vector<uint64_t> loaded_obstacle_layouts =
+        pack_obstacle_layouts(obstacle_layouts_data.get<vector<vector<int>>>());
+
+    return [=]() -> void
+    {
+        obstacle_layouts = loaded_obstacle_layouts;
+    };
+}
+
+
+static Entity get_pooled_tile(Tile_Types tile_type)
+{
+    static const map<Tile_Types, const string> TILE_TYPE_BLUEPRINTS
+    {
+        { Tile_Types::WALL              , "wall_tile"              },
+        { Tile_Types::WALL_CORNER       , "wall_corner_tile"       },
+        { Tile_Types::WALL_CORNER_INNER , "wall_corner_inner_tile" },
+        { Tile_Types::DOOR              , "door_tile"              },
+        { Tile_Types::FLOOR             , "floor_tile"             },
+        { Tile_Types::FLOOR_LEDGE       , "floor_ledge_tile"       },
+        { Tile_Types::FLOOR_HOLE        , "floor_hole_tile"        },
+        { Tile_Types::LEFT_DOOR_WALL    , "left_door_wall_tile"    },
+        { Tile_Types::RIGHT_DOOR_WALL   , "right_door_wall_tile"   },
+        { Tile_Types::NEXT_FLOOR        , "next_floor_tile"        },
+    };
+
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    vector<Entity> & tile_pool = floor_state.tile_pools[tile_type];
+
+    if (tile_pool.size() == 0)
+    {
+        return load_blueprint(TILE_TYPE_BLUEPRINTS.at(tile_type));
+    }
+
+    const Entity tile = tile_pool.back();
+    tile_pool.pop_back();
+    return tile;
+}
+
+
 static void generate_room(int x, int y, int id, int max_size)
 {
+    Floor_Manager_State & floor_state = get_world().floor_manager;
     Possible_Rooms room_extensions;
-    Room_Data & room_data = room_datas[id];
+    Room_Data & room_data = floor_state.room_datas[id];
     vec2 & room_origin = room_data.origin;
     vec2 & room_bounds = room_data.bounds;
     int room_origin_x = x;
@@ -254,10 +609,165 @@ static void generate_room(int x, int y, int id, int max_size)
 }
 
 
+// Every edge shared by sections of two different rooms has a door, so the room graph is built from the room layout
+// alone.
+static void build_room_graph(int last_room_id)
+{
+    const Frame_Arena_Scope frame_arena_scope;
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    floor_state.room_door_offsets.assign(last_room_id + 2, 0);
+    floor_state.room_neighbor_offsets.assign(last_room_id + 2, 0);
+    floor_state.room_neighbors.clear();
+    floor_state.room_section_offsets.assign(last_room_id + 2, 0);
+    floor_state.room_depths.assign(last_room_id + 1, -1);
+
+
+    // Count each room's doors and sections, then turn the counts into offsets and fill each room's ranges in the same
+    // order.
+    iterate_rooms([&](int x, int y, int & room) -> void
+    {
+        if (room > 0)
+        {
+            floor_state.room_section_offsets[room + 1]++;
+        }
+
+        for (const ivec2 & neighbor_offset : ROOM_EDGE_NEIGHBOR_OFFSETS)
+        {
+            const int neighbor = get_room(x + neighbor_offset.x, y + neighbor_offset.y);
+
+            if (room > 0 && neighbor > 0 && neighbor != room)
+            {
+                floor_state.room_door_offsets[room + 1]++;
+            }
+        }
+    });
+
+    for (int room = 1; room <= last_room_id + 1; room++)
+    {
+        floor_state.room_door_offsets[room] += floor_state.room_door_offsets[room - 1];
+        floor_state.room_section_offsets[room] += floor_state.room_section_offsets[room - 1];
+    }
+
+    Frame_Vector<int> room_door_counts(last_room_id + 1, 0);
+    Frame_Vector<int> room_section_counts(last_room_id + 1, 0);
+    floor_state.room_doors.resize(floor_state.room_door_offsets[last_room_id + 1]);
+    floor_state.room_sections.resize(floor_state.room_section_offsets[last_room_id + 1]);
+
+    iterate_rooms([&](int x, int y, int & room) -> void
+    {
+        if (room > 0)
+        {
+            floor_state.room_sections[floor_state.room_section_offsets[room] + room_section_counts[room]++] =
+                ivec2(x, y);
+        }
+
+        for (int edge = 0; edge < ROOM_EDGE_COUNT; edge++)
+        {
+            const ivec2 & neighbor_offset = ROOM_EDGE_NEIGHBOR_OFFSETS[edge];
+            const int neighbor = get_room(x + neighbor_offset.x, y + neighbor_offset.y);
+
+            if (room > 0 && neighbor > 0 && neighbor != room)
+            {
+                floor_state.room_doors[floor_state.room_door_offsets[room] + room_door_counts[room]++] =
+                {
+                    neighbor,
+                    ivec2(x * ROOM_TILE_WIDTH, y * ROOM_TILE_HEIGHT) + ROOM_EDGE_DOOR_COORDINATES[edge],
+                };
+            }
+        }
+    });
+
+
+    // Rooms can share several doors, so each room's neighbors are its doors' rooms without repeats.
+    vector<int> & room_neighbors = floor_state.room_neighbors;
+
+    for (int room = 0; room <= last_room_id; room++)
+    {
+        const int room_neighbors_begin = room_neighbors.size();
+        floor_state.room_neighbor_offsets[room] = room_neighbors_begin;
+
+        for (const Room_Door & room_door : get_room_doors(room))
+        {
+            if (find(room_neighbors.begin() + room_neighbors_begin, room_neighbors.end(), room_door.room) ==
+                room_neighbors.end())
+            {
+                room_neighbors.push_back(room_door.room);
+            }
+        }
+    }
+
+    floor_state.room_neighbor_offsets[last_room_id + 1] = floor_state.room_neighbors.size();
+
+
+    // Breadth-first search out from the spawn room for room depths.
+    Frame_Vector<int> room_queue { SPAWN_ROOM_ID };
+    floor_state.room_depths[SPAWN_ROOM_ID] = 0;
+    floor_state.max_room_depth = 0;
+
+    for (size_t i = 0; i < room_queue.size(); i++)
+    {
+        const int room = room_queue[i];
+
+        for (const int neighbor : get_room_neighbors(room))
+        {
+            int & neighbor_depth = floor_state.room_depths[neighbor];
+
+            if (neighbor_depth == -1)
+            {
+                neighbor_depth = floor_state.room_depths[room] + 1;
+                floor_state.max_room_depth = neighbor_depth;
+                room_queue.push_back(neighbor);
+            }
+        }
+    }
+}
+
+
+// Picks one of the possible rooms that would be farthest from the spawn room, going by the room graph of the rooms
+// generated so far. A possible room can border shallower rooms too, so this isn't always deeper than every other room.
+static ivec2 get_farthest_possible_room()
+{
+    const Frame_Arena_Scope frame_arena_scope;
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    Frame_Vector<ivec2> farthest_possible_rooms;
+    int farthest_depth = -1;
+
+    for_each(floor_state.current_floor.possible_rooms, [&](int * /*room*/, const ivec2 & coordinates) -> void
+    {
+        // A room here would be one door past the shallowest room it borders.
+        int depth = INT_MAX;
+
+        for (const ivec2 & neighbor_offset : ROOM_EDGE_NEIGHBOR_OFFSETS)
+        {
+            const int neighbor = get_room(coordinates.x + neighbor_offset.x, coordinates.y + neighbor_offset.y);
+
+            if (neighbor > 0 && floor_state.room_depths[neighbor] + 1 < depth)
+            {
+                depth = floor_state.room_depths[neighbor] + 1;
+            }
+        }
+
+        if (depth > farthest_depth)
+        {
+            farthest_depth = depth;
+            farthest_possible_rooms.clear();
+        }
+
+        if (depth == farthest_depth)
+        {
+            farthest_possible_rooms.push_back(coordinates);
+        }
+    });
+
+    return farthest_possible_rooms[random(0, farthest_possible_rooms.size())];
+}
+
+
 static void debug_floor()
 {
-    const int size = current_floor.size;
-    const int * rooms = current_floor.rooms;
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    const int size = floor_state.current_floor.size;
+    const int * rooms = floor_state.current_floor.rooms;
 
     for (int i = 0; i < size + 2; i++)
     {
@@ -290,77 +800,62 @@ static void debug_floor()
 }
 
 
-static void generate_wall_tile(
-    Tile & tile,
-    int coordinate,
-    int dimension_size,
-    int room,
-    int neighbor,
-    int clockwise_neighbor,
-    float rotation,
-    bool inverted = false)
+static void allocate_floor(int floor_size)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    const int room_tiles_width = floor_size * ROOM_TILE_WIDTH;
+    const int room_count = floor_size * floor_size;
+    floor_state.current_floor.size = floor_size;
+    floor_state.current_floor.room_tiles_width = room_tiles_width;
+    floor_state.current_floor.rooms = new int[room_count];
+    floor_state.current_floor.room_obstacle_layouts = new int[room_count];
+    floor_state.current_floor.room_tiles = new Packed_Tile[room_count * ROOM_TILE_COUNT];
+}
+
+
+static void calculate_room_datas()
 {
-    tile.rotation = rotation;
+    static const ivec2 UNSEEN_ROOM(-1);
+
+    const Frame_Arena_Scope frame_arena_scope;
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    Frame_Vector<ivec2> room_origins(floor_state.max_room_id + 1, UNSEEN_ROOM);
+    Frame_Vector<ivec2> room_bounds(floor_state.max_room_id + 1, UNSEEN_ROOM);
 
-    // Corner
-    if ((inverted && coordinate == dimension_size - 1) || coordinate == 0)
+    iterate_rooms([&](int x, int y, const int & room) -> void
     {
-        // Inner corner
-        if (neighbor == room && clockwise_neighbor == room)
-        {
-            tile.type = Tile_Types::WALL_CORNER_INNER;
-        }
-        // Wall to neighbor
-        else if (neighbor == room)
-        {
-            tile.type = Tile_Types::WALL;
-            tile.rotation -= 90.0f;
-        }
-        // Wall to clockwise_neighbor
-        else if (clockwise_neighbor == room)
+        if (room == 0)
         {
-            tile.type = Tile_Types::WALL;
+            return;
         }
-        // Outer corner
-        else
+
+        ivec2 & room_origin = room_origins[room];
+        ivec2 & room_bound = room_bounds[room];
+
+        if (room_origin == UNSEEN_ROOM)
         {
-            tile.type = Tile_Types::WALL_CORNER;
+            room_origin = ivec2(x, y);
+            room_bound = ivec2(x, y);
+            return;
         }
-    }
-    // Floor between rooms
-    else if (neighbor == room)
-    {
-        tile.type = Tile_Types::FLOOR;
-        tile.rotation = 0.0f;
-    }
-    // Wall
-    else if (neighbor > 0)
+
+        room_origin = min(room_origin, ivec2(x, y));
+        room_bound = max(room_bound, ivec2(x, y));
+    });
+
+    for (int room = 1; room <= floor_state.max_room_id; room++)
     {
-        // Door
-        if (coordinate == (dimension_size - 1) / 2)
-        {
-            tile.type = Tile_Types::DOOR;
-        }
-        // Door-adjacent wall
-        else if (coordinate == (dimension_size - 2) / 2)
-        {
-            tile.type = inverted ? Tile_Types::LEFT_DOOR_WALL : Tile_Types::RIGHT_DOOR_WALL;
-        }
-        // Door-adjacent wall
-        else if (coordinate == ((dimension_size - 2) / 2) + 2)
-        {
-            tile.type = inverted ? Tile_Types::RIGHT_DOOR_WALL : Tile_Types::LEFT_DOOR_WALL;
-        }
-        // Normal wall
-        else
+        const ivec2 & room_origin = room_origins[room];
+        const ivec2 & room_bound = room_bounds[room];
+
+        if (room_origin == UNSEEN_ROOM)
         {
-            tile.type = Tile_Types::WALL;
+            continue;
         }
-    }
-    // Normal wall
-    else
-    {
-        tile.type = Tile_Types::WALL;
+
+        Room_Data & room_data = floor_state.room_datas[room];
+        room_data.origin = get_room_center(room_origin.x, room_origin.y);
+        room_data.bounds = get_room_center(room_bound.x, room_bound.y);
     }
 }
 
@@ -378,9 +873,135 @@ static int get_room_tile_position_coordinate(float position, float tile_unit_siz
 }
 
 
-static float get_room_tile_coordinate_position(int coordinate, float tile_unit_size)
-{
-    return coordinate * tile_unit_size;
+static float get_room_tile_coordinate_position(int coordinate, float tile_unit_size)
+{
+    return coordinate * tile_unit_size;
+}
+
+
+static int get_floor_tile_index(const ivec2 & coordinates)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    const int floor_tiles_height = floor_state.current_floor.size * ROOM_TILE_HEIGHT;
+
+    return coordinates.x < 0 || coordinates.x >= floor_state.current_floor.room_tiles_width ||
+           coordinates.y < 0 || coordinates.y >= floor_tiles_height
+           ? -1
+           : (coordinates.y * floor_state.current_floor.room_tiles_width) + coordinates.x;
+}
+
+
+static void swap_floor_tile_slots(int slot_a, int slot_b)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    ivec2 & floor_tile_a = floor_state.floor_tiles[slot_a];
+    ivec2 & floor_tile_b = floor_state.floor_tiles[slot_b];
+    floor_state.floor_tile_slots[get_floor_tile_index(floor_tile_a)] = slot_b;
+    floor_state.floor_tile_slots[get_floor_tile_index(floor_tile_b)] = slot_a;
+    swap(floor_tile_a, floor_tile_b);
+}
+
+
+static void index_floor_tiles()
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    const Floor & current_floor = floor_state.current_floor;
+    const int floor_tile_count = current_floor.room_tiles_width * current_floor.size * ROOM_TILE_HEIGHT;
+    floor_state.room_floor_tiles.assign(floor_state.max_room_id + 1, { 0, 0, 0 });
+    floor_state.floor_tile_slots.assign(floor_tile_count, -1);
+    floor_state.floor_tile_occupant_counts.assign(floor_tile_count, 0);
+    floor_state.floor_tile_occupants.clear();
+
+
+    // Count floor tiles per room, then lay out each room's range in room id order.
+    iterate_room_tiles([&](int /*x*/, int /*y*/, const Tile & tile) -> void
+    {
+        if (tile.type == Tile_Types::FLOOR)
+        {
+            floor_state.room_floor_tiles[tile.room].count++;
+        }
+    });
+
+    int begin = 0;
+
+    for (Room_Floor_Tiles & room_floor_tile_range : floor_state.room_floor_tiles)
+    {
+        room_floor_tile_range.begin = begin;
+        begin += room_floor_tile_range.count;
+    }
+
+    floor_state.floor_tiles.resize(begin);
+
+    iterate_room_tiles([&](int x, int y, const Tile & tile) -> void
+    {
+        if (tile.type != Tile_Types::FLOOR)
+        {
+            return;
+        }
+
+        Room_Floor_Tiles & room_floor_tile_range = floor_state.room_floor_tiles[tile.room];
+        const int slot = room_floor_tile_range.begin + room_floor_tile_range.free_count++;
+        floor_state.floor_tiles[slot] = ivec2(x, y);
+        floor_state.floor_tile_slots[get_floor_tile_index(ivec2(x, y))] = slot;
+    });
+}
+
+
+static void add_floor_tile_occupant(const ivec2 & coordinates)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    const int index = get_floor_tile_index(coordinates);
+
+
+    // Ignore out-of-bounds tiles and tiles that are already occupied.
+    if (index == -1 || floor_state.floor_tile_occupant_counts[index]++ > 0)
+    {
+        return;
+    }
+
+
+    const int slot = floor_state.floor_tile_slots[index];
+
+    if (slot == -1)
+    {
+        return;
+    }
+
+
+    // Swap tile with the last free tile in its room's range and shrink the free range past it.
+    const int room = get_room_tile(coordinates.x, coordinates.y).room;
+    Room_Floor_Tiles & room_floor_tile_range = floor_state.room_floor_tiles[room];
+    swap_floor_tile_slots(slot, room_floor_tile_range.begin + --room_floor_tile_range.free_count);
+}
+
+
+static void remove_floor_tile_occupant(const ivec2 & coordinates)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    const int index = get_floor_tile_index(coordinates);
+
+
+    // Ignore out-of-bounds tiles and tiles that are still occupied by something else.
+    vector<int> & floor_tile_occupant_counts = floor_state.floor_tile_occupant_counts;
+
+    if (index == -1 || floor_tile_occupant_counts[index] == 0 || --floor_tile_occupant_counts[index] > 0)
+    {
+        return;
+    }
+
+
+    const int slot = floor_state.floor_tile_slots[index];
+
+    if (slot == -1)
+    {
+        return;
+    }
+
+
+    // Swap tile with the first occupied tile in its room's range and grow the free range over it.
+    const int room = get_room_tile(coordinates.x, coordinates.y).room;
+    Room_Floor_Tiles & room_floor_tile_range = floor_state.room_floor_tiles[room];
+    swap_floor_tile_slots(slot, room_floor_tile_range.begin + room_floor_tile_range.free_count++);
 }
 
 
@@ -393,40 +1014,55 @@ void floor_manager_api_init()
 {
     room_tile_unit_size = vec3(1) * (float)(ROOM_TILE_TEXTURE_SIZE / get_pixels_per_unit());
     room_tile_unit_size.z = 1;
-    obstacle_layouts = read_json_file("resources/data/obstacle_layouts.json").get<vector<vector<int>>>();
+    load_data_file("resources/data/obstacle_layouts.json", load_obstacle_layouts);
+    set_floor_streaming(read_json_file("resources/data/floor_settings.json")["streaming"]);
+}
+
+
+void set_obstacle_layouts(const vector<vector<int>> & _obstacle_layouts)
+{
+    obstacle_layouts = pack_obstacle_layouts(_obstacle_layouts);
 }
 
 
 void generate_floor(int floor_size)
 {
+    generate_floor_layout(floor_size);
+    debug_floor();
+    build_floor();
+}
+
+
+void generate_floor_layout(int floor_size)
+{
+    generate_floor_rooms(floor_size);
+    generate_floor_tiles();
+}
+
+
+void generate_floor_rooms(int floor_size)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+
     // Create floor.
-    const int room_tiles_width = floor_size * ROOM_TILE_WIDTH;
-    Possible_Rooms & possible_rooms = current_floor.possible_rooms;
-    current_floor.size = floor_size;
-    current_floor.room_tiles_width = room_tiles_width;
-    current_floor.rooms = new int[floor_size * floor_size];
-    current_floor.room_tiles = new Tile[room_tiles_width * (floor_size * ROOM_TILE_HEIGHT)];
+    Possible_Rooms & possible_rooms = floor_state.current_floor.possible_rooms;
+    allocate_floor(floor_size);
     iterate_rooms([](int /*x*/, int /*y*/, int & room) -> void { room = 0; });
 
-    iterate_room_tiles([](int /*x*/, int /*y*/, Tile & room_tile) -> void
-    {
-        room_tile.type = Tile_Types::NONE;
-        room_tile.rotation = 0.0f;
-    });
-
 
     // Generate rooms.
     static const int MAX_ROOM_SIZE = 4;
 
     // Calculate the max number of fully-sized rooms that can be generated. The "- 2" & "+ 2" account for the spawn and
     // boss rooms being size 1, therefore not being required to be multiplied by MAX_ROOM_SIZE.
-    max_room_id = (((floor_size * floor_size) - 2) / MAX_ROOM_SIZE) + 2;
+    floor_state.max_room_id = (((floor_size * floor_size) - 2) / MAX_ROOM_SIZE) + 2;
 
     const int root_room_x = random(0, floor_size);
     const int root_room_y = random(0, floor_size);
     generate_room(root_room_x, root_room_y, SPAWN_ROOM_ID, 1);
 
-    for (int room_id = SPAWN_ROOM_ID + 1; room_id <= max_room_id; room_id++)
+    for (int room_id = SPAWN_ROOM_ID + 1; room_id <= floor_state.max_room_id; room_id++)
     {
         // No possible rooms available.
         if (possible_rooms.size() == 0)
@@ -434,7 +1070,16 @@ void generate_floor(int floor_size)
             throw runtime_error("ERROR: exhausted possible rooms for generation before reaching max room ID!");
         }
 
-        ivec2 room_coordinates = at_index(possible_rooms, random(0, possible_rooms.size())).second;
+        // The boss room is placed as far from the spawn room as possible.
+        if (room_id == floor_state.max_room_id)
+        {
+            build_room_graph(room_id - 1);
+        }
+
+        const ivec2 room_coordinates =
+            room_id == floor_state.max_room_id
+            ? get_farthest_possible_room()
+            : at_index(possible_rooms, random(0, possible_rooms.size())).second;
 
         generate_room(
             room_coordinates.x,
@@ -442,117 +1087,169 @@ void generate_floor(int floor_size)
             room_id,
 
             // If boss room size changes, max_room_id calculation needs to be updated.
-            room_id == max_room_id ? 1 : MAX_ROOM_SIZE);
+            room_id == floor_state.max_room_id ? 1 : MAX_ROOM_SIZE);
     }
 
-    spawn_position = get_room_center(root_room_x, root_room_y);
-    debug_floor();
+    build_room_graph(floor_state.max_room_id);
+    floor_state.spawn_position = get_room_center(root_room_x, root_room_y);
+}
+
+
+void generate_floor_tiles()
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    const int floor_size = floor_state.current_floor.size;
+
+    fill(
+        floor_state.current_floor.room_tiles,
+        floor_state.current_floor.room_tiles + (floor_size * floor_size * ROOM_TILE_COUNT),
+        pack_tile(Tile_Types::NONE, 0.0f));
 
 
     // Generate room tiles.
     iterate_rooms([&](int room_x, int room_y, int & room) -> void
     {
+        int & room_obstacle_layout =
+            *array_2d_at(floor_state.current_floor.room_obstacle_layouts, floor_size, room_x, room_y);
+
+
         // Don't generate tiles for empty rooms.
         if (room == 0)
         {
+            room_obstacle_layout = -1;
             return;
         }
 
 
-        const vector<int> & obstacle_layout =
-            obstacle_layouts[room == SPAWN_ROOM_ID ? 0 : random(0, obstacle_layouts.size())];
+        room_obstacle_layout = room == SPAWN_ROOM_ID ? 0 : random(0, get_obstacle_layout_count());
+        const uint64_t * obstacle_layout = &obstacle_layouts[room_obstacle_layout * OBSTACLE_LAYOUT_WORD_COUNT];
+
 
-        iterate_room_tiles(room_x, room_y, true, [&](int x, int y, Tile & tile) -> void
+        // Stamp the obstacle layout over the room's floor a row at a time.
+        Packed_Tile * room_section_tiles =
+            &floor_state.current_floor.room_tiles[get_room_section_index(room_x, room_y) * ROOM_TILE_COUNT];
+
+        for (int y = 1; y < ROOM_TILE_HEIGHT - 1; y++)
         {
-            tile.room = room;
+            const int row_index = y * ROOM_TILE_WIDTH;
 
-            // Floor
-            if (x > 0 && x < ROOM_TILE_WIDTH - 1 &&
-                y > 0 && y < ROOM_TILE_HEIGHT - 1)
+            for (int x = 1; x < ROOM_TILE_WIDTH - 1; x++)
             {
-                if (room == max_room_id &&
-                    x == (ROOM_TILE_WIDTH - 1) / 2 &&
-                    y == (ROOM_TILE_HEIGHT - 1) / 2)
-                {
-                    tile.type = Tile_Types::NEXT_FLOOR;
-                }
-                else
-                {
-                    static const map<int, Tile_Types> OBSTACLE_LAYOUT_TILE_TYPES
-                    {
-                        { 0, Tile_Types::FLOOR       },
-                        { 1, Tile_Types::FLOOR_LEDGE },
-                        { 2, Tile_Types::FLOOR_HOLE  },
-                    };
+                room_section_tiles[row_index + x] =
+                    pack_tile(get_obstacle_layout_tile_type(obstacle_layout, row_index + x), 0.0f);
+            }
+        }
 
-                    tile.type = OBSTACLE_LAYOUT_TILE_TYPES.at(
-                        obstacle_layout[((ROOM_TILE_HEIGHT - y - 1) * ROOM_TILE_WIDTH) + x]);
-                }
+        if (room == floor_state.max_room_id)
+        {
+            room_section_tiles[(((ROOM_TILE_HEIGHT - 1) / 2) * ROOM_TILE_WIDTH) + ((ROOM_TILE_WIDTH - 1) / 2)] =
+                pack_tile(Tile_Types::NEXT_FLOOR, 0.0f);
+        }
 
-                tile.rotation = 0.0f;
-            }
-            // Wall
-            else
-            {
-                const int bottom_neighbor = get_room(room_x, room_y - 1);
-                const int left_neighbor = get_room(room_x - 1, room_y);
-                const int top_neighbor = get_room(room_x, room_y + 1);
-                const int right_neighbor = get_room(room_x + 1, room_y);
 
-                // Bottom wall
-                if (y == 0 && x != ROOM_TILE_WIDTH - 1)
-                {
-                    generate_wall_tile(tile, x, ROOM_TILE_WIDTH, room, bottom_neighbor, left_neighbor, 0.0f);
-                }
-                // Left wall
-                else if (x == 0 && y != 0)
-                {
-                    generate_wall_tile(tile, y, ROOM_TILE_HEIGHT, room, left_neighbor, top_neighbor, 270.0f, true);
-                }
-                // Top wall
-                else if (y == ROOM_TILE_HEIGHT - 1 && x != 0)
-                {
-                    generate_wall_tile(tile, x, ROOM_TILE_WIDTH, room, top_neighbor, right_neighbor, 180.0f, true);
-                }
-                // Right wall
-                else if (x == ROOM_TILE_WIDTH - 1 && y != ROOM_TILE_HEIGHT - 1)
-                {
-                    generate_wall_tile(tile, y, ROOM_TILE_HEIGHT, room, right_neighbor, bottom_neighbor, 90.0f);
-                }
+        // Stamp the room's walls from the wall tile table, looking up each edge's neighbors once.
+        for (int edge = 0; edge < ROOM_EDGE_COUNT; edge++)
+        {
+            const int edge_mask = get_room_edge_mask(room_x, room_y, room, edge);
+            const Packed_Tile * wall_tiles = WALL_TILE_TABLE.tiles[edge][edge_mask];
+            const int * tile_indexes = WALL_TILE_TABLE.tile_indexes[edge];
+
+            for (int position = 0; position < WALL_TILE_TABLE.edge_lengths[edge]; position++)
+            {
+                room_section_tiles[tile_indexes[position]] = wall_tiles[position];
             }
-        });
+        }
     });
 
+    index_floor_tiles();
+}
+
+
+void load_floor_layout(
+    int floor_size,
+    const int * rooms,
+    const int * room_obstacle_layouts,
+    const Packed_Tile * room_tiles)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    const int room_count = floor_size * floor_size;
+    allocate_floor(floor_size);
+    copy(rooms, rooms + room_count, floor_state.current_floor.rooms);
+    copy(room_obstacle_layouts, room_obstacle_layouts + room_count, floor_state.current_floor.room_obstacle_layouts);
+    copy(room_tiles, room_tiles + (room_count * ROOM_TILE_COUNT), floor_state.current_floor.room_tiles);
+
+
+    // Restore room data derived from the room layout; the spawn room is always a single room.
+    floor_state.max_room_id = *max_element(rooms, rooms + room_count);
+    build_room_graph(floor_state.max_room_id);
+    calculate_room_datas();
+    floor_state.spawn_position = floor_state.room_datas.at(SPAWN_ROOM_ID).origin;
+    index_floor_tiles();
+}
+
+
+void build_floor()
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
 
-    // Create tiles for each room based on each tile's type.
-    iterate_rooms([&](int room_x, int room_y, int & room_id) -> void
+    // When streaming, only the spawn room and its door-adjacent neighbors are built, and the rest are built as the
+    // player approaches them.
+    if (floor_streaming)
     {
-        // Don't generate tiles for empty rooms.
-        if (room_id == 0)
+        for (const int room : get_room_neighborhood(SPAWN_ROOM_ID))
         {
-            return;
+            build_room(room);
+        }
+    }
+    else
+    {
+        for (int room = SPAWN_ROOM_ID; room <= floor_state.max_room_id; room++)
+        {
+            build_room(room);
+        }
+    }
+
+
+    // Lock current room if its enemy count is > 0.
+    game_manager_add_room_change_handler(ROOM_CHANGE_HANDLER_ID, [](int /*last_room*/, int current_room) -> void
+    {
+        if (get_room_enemy_count(current_room) > 0)
+        {
+            set_room_locked(current_room, true);
         }
+    });
+
+
+    // Trigger floor generated handlers.
+    for_each(floor_generated_handlers, [](const string & /*id*/, const function<void()> & handler) -> void
+    {
+        handler();
+    });
+}
+
+
+void build_room(int room)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+    if (contains_key(floor_state.built_room_tiles, room))
+    {
+        throw runtime_error("ERROR: room " + to_string(room) + " has already been built!");
+    }
 
+    vector<Room_Tile_Entity> & room_tile_entities = floor_state.built_room_tiles[room];
 
-        iterate_room_tiles(room_x, room_y, false, [&](
+
+    // Create tiles for each of the room's sections based on each tile's type.
+    for (const ivec2 & room_section : get_room_sections(room))
+    {
+        iterate_room_tiles(room_section.x, room_section.y, false, [&](
             int tile_x,
             int tile_y,
-            const Tile & tile_data) -> void
+            Packed_Tile & packed_tile) -> void
         {
-            static const map<Tile_Types, const string> TILE_TYPE_BLUEPRINTS
-            {
-                { Tile_Types::WALL              , "wall_tile"              },
-                { Tile_Types::WALL_CORNER       , "wall_corner_tile"       },
-                { Tile_Types::WALL_CORNER_INNER , "wall_corner_inner_tile" },
-                { Tile_Types::DOOR              , "door_tile"              },
-                { Tile_Types::FLOOR             , "floor_tile"             },
-                { Tile_Types::FLOOR_LEDGE       , "floor_ledge_tile"       },
-                { Tile_Types::FLOOR_HOLE        , "floor_hole_tile"        },
-                { Tile_Types::LEFT_DOOR_WALL    , "left_door_wall_tile"    },
-                { Tile_Types::RIGHT_DOOR_WALL   , "right_door_wall_tile"   },
-                { Tile_Types::NEXT_FLOOR        , "next_floor_tile"        },
-            };
-
+            const Tile tile_data = unpack_tile(packed_tile, room);
             const Tile_Types tile_type = tile_data.type;
 
             if (tile_type == Tile_Types::NONE)
@@ -563,22 +1260,23 @@ void generate_floor(int floor_size)
 
             // Create tile entity, set its position and rotation, and track it.
             const float tile_rotation = tile_data.rotation;
-            const Entity tile = load_blueprint(TILE_TYPE_BLUEPRINTS.at(tile_type));
-            auto transform = (Transform *)get_component(tile, "transform");
+            const Entity tile = get_pooled_tile(tile_type);
+            auto transform = component<Transform>(tile);
             vec3 & position = transform->position;
             transform->rotation = tile_rotation;
             position = vec3(tile_x, tile_y, 0.0f) * room_tile_unit_size;
             position.z = ROOM_Z;
-            game_manager_track_render_flag(room_id, tile);
+            room_tile_entities.push_back({ tile, tile_type });
+            game_manager_track_render_flag(room, tile);
 
-            if (has_component(tile, "collider"))
+            if (has<Collider>(tile))
             {
-                game_manager_track_collider_enabled_flag(room_id, tile);
+                game_manager_track_collider_enabled_flag(room, tile);
             }
 
-            if (has_component(tile, "light_source"))
+            if (has<Light_Source>(tile))
             {
-                game_manager_track_light_source_enabled_flag(room_id, tile);
+                game_manager_track_light_source_enabled_flag(room, tile);
             }
 
 
@@ -586,9 +1284,9 @@ void generate_floor(int floor_size)
             if (tile_type == Tile_Types::DOOR ||
                 tile_type == Tile_Types::NEXT_FLOOR)
             {
-                auto room_exit = (Room_Exit *)get_component(tile, "room_exit");
-                auto collider = ((Collider *)get_component(tile, "collider"));
-                room_exits[room_id].push_back(tile);
+                auto room_exit = component<Room_Exit>(tile);
+                auto collider = component<Collider>(tile);
+                floor_state.room_exits[room].push_back(tile);
 
                 if (tile_type == Tile_Types::DOOR)
                 {
@@ -612,59 +1310,227 @@ void generate_floor(int floor_size)
                 }
             }
         });
-    });
+    }
+}
 
 
-    // Lock current room if its enemy count is > 0.
-    game_manager_add_room_change_handler(ROOM_CHANGE_HANDLER_ID, [](int /*last_room*/, int current_room) -> void
+void release_room(int room)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+    if (!contains_key(floor_state.built_room_tiles, room))
+    {
+        throw runtime_error("ERROR: room " + to_string(room) + " has not been built!");
+    }
+
+
+    // Unlock the room's exits so their tiles return to the pool without a locked texture or door lock.
+    if (contains_key(floor_state.room_exits, room))
+    {
+        set_room_locked(room, false);
+        remove(floor_state.room_exits, room);
+    }
+
+
+    // Released rooms are never the current room, so their tiles are already disabled by the game manager and only need
+    // to be untracked before returning to their pools.
+    for (const Room_Tile_Entity & room_tile_entity : floor_state.built_room_tiles.at(room))
     {
-        if (room_enemies[current_room].size() > 0)
+        const Entity tile = room_tile_entity.entity;
+        game_manager_untrack_render_flag(room, tile);
+
+        if (has<Collider>(tile))
         {
-            set_room_locked(current_room, true);
+            game_manager_untrack_collider_enabled_flag(room, tile);
+        }
+
+        if (has<Light_Source>(tile))
+        {
+            game_manager_untrack_light_source_enabled_flag(room, tile);
         }
-    });
 
+        floor_state.tile_pools[room_tile_entity.type].push_back(tile);
+    }
 
-    // Trigger floor generated handlers.
-    for_each(floor_generated_handlers, [](const string & /*id*/, const function<void()> & handler) -> void
+    remove(floor_state.built_room_tiles, room);
+}
+
+
+bool is_room_built(int room)
+{
+    return contains_key(get_world().floor_manager.built_room_tiles, room);
+}
+
+
+vector<int> get_built_rooms()
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    vector<int> built_rooms;
+
+    for_each(floor_state.built_room_tiles, [&](
+        int room,
+        const vector<Room_Tile_Entity> & /*room_tile_entities*/) -> void
     {
-        handler();
+        built_rooms.push_back(room);
     });
+
+    return built_rooms;
+}
+
+
+void get_room_stream_changes(
+    int room,
+    const vector<int> & built_rooms,
+    vector<int> & released_rooms,
+    vector<int> & unbuilt_rooms)
+{
+    const vector<int> room_neighborhood = get_room_neighborhood(room);
+
+    for (const int built_room : built_rooms)
+    {
+        if (!contains(room_neighborhood, built_room))
+        {
+            released_rooms.push_back(built_room);
+        }
+    }
+
+    for (const int neighborhood_room : room_neighborhood)
+    {
+        if (!contains(built_rooms, neighborhood_room))
+        {
+            unbuilt_rooms.push_back(neighborhood_room);
+        }
+    }
+}
+
+
+vector<int> get_room_neighborhood(int room)
+{
+    const Room_Graph_Range<int> neighbors = get_room_neighbors(room);
+    vector<int> neighborhood { room };
+    neighborhood.insert(neighborhood.end(), begin(neighbors), end(neighbors));
+    return neighborhood;
+}
+
+
+Room_Graph_Range<int> get_room_neighbors(int room)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+    return
+    {
+        floor_state.room_neighbors.data() + floor_state.room_neighbor_offsets[room],
+        floor_state.room_neighbors.data() + floor_state.room_neighbor_offsets[room + 1],
+    };
+}
+
+
+Room_Graph_Range<Room_Door> get_room_doors(int room)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+    return
+    {
+        floor_state.room_doors.data() + floor_state.room_door_offsets[room],
+        floor_state.room_doors.data() + floor_state.room_door_offsets[room + 1],
+    };
+}
+
+
+Room_Graph_Range<ivec2> get_room_sections(int room)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+    return
+    {
+        floor_state.room_sections.data() + floor_state.room_section_offsets[room],
+        floor_state.room_sections.data() + floor_state.room_section_offsets[room + 1],
+    };
+}
+
+
+int get_room_depth(int room)
+{
+    return get_world().floor_manager.room_depths[room];
+}
+
+
+int get_max_room_depth()
+{
+    return get_world().floor_manager.max_room_depth;
+}
+
+
+void set_floor_streaming(bool _floor_streaming)
+{
+    floor_streaming = _floor_streaming;
+}
+
+
+bool is_floor_streaming()
+{
+    return floor_streaming;
 }
 
 
 void destroy_floor()
 {
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+
     // Cleanup current floor data.
-    current_floor.size = 0;
-    current_floor.room_tiles_width = 0;
-    delete[] current_floor.rooms;
-    delete[] current_floor.room_tiles;
-    current_floor.possible_rooms.clear();
+    floor_state.current_floor.size = 0;
+    floor_state.current_floor.room_tiles_width = 0;
+    delete[] floor_state.current_floor.rooms;
+    delete[] floor_state.current_floor.room_obstacle_layouts;
+    delete[] floor_state.current_floor.room_tiles;
+    floor_state.current_floor.possible_rooms.clear();
 
 
     // Cleanup room data.
-    room_datas.clear();
-    room_enemies.clear();
-    room_exits.clear();
+    floor_state.room_datas.clear();
+    floor_state.room_enemies.clear();
+    floor_state.room_exits.clear();
+    floor_state.room_door_offsets.clear();
+    floor_state.room_doors.clear();
+    floor_state.room_neighbor_offsets.clear();
+    floor_state.room_neighbors.clear();
+    floor_state.room_section_offsets.clear();
+    floor_state.room_sections.clear();
+    floor_state.room_depths.clear();
+    floor_state.max_room_depth = 0;
     game_manager_remove_room_change_handler(ROOM_CHANGE_HANDLER_ID);
+
+
+    // Tile entities are destroyed along with the rest of the floor's entities.
+    floor_state.built_room_tiles.clear();
+    floor_state.tile_pools.clear();
+
+
+    // Cleanup floor tile occupancy data.
+    floor_state.floor_tiles.clear();
+    floor_state.room_floor_tiles.clear();
+    floor_state.floor_tile_slots.clear();
+    floor_state.floor_tile_occupant_counts.clear();
+    floor_state.floor_tile_occupants.clear();
 }
 
 
 const vec2 & get_spawn_position()
 {
-    return spawn_position;
+    return get_world().floor_manager.spawn_position;
 }
 
 
 int get_room(int x, int y)
 {
-    const int floor_size = current_floor.size;
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    const int floor_size = floor_state.current_floor.size;
 
     return x < 0 || x >= floor_size ||
            y < 0 || y >= floor_size
            ? -1
-           : *array_2d_at(current_floor.rooms, floor_size, x, y);
+           : *array_2d_at(floor_state.current_floor.rooms, floor_size, x, y);
 }
 
 
@@ -678,35 +1544,56 @@ int get_room(const vec3 & position)
 
 const Room_Data & get_room_data(int room)
 {
-    return room_datas.at(room);
+    return get_world().floor_manager.room_datas.at(room);
+}
+
+
+int get_room_obstacle_layout(int x, int y)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+    return *array_2d_at(floor_state.current_floor.room_obstacle_layouts, floor_state.current_floor.size, x, y);
+}
+
+
+Tile get_room_tile(int x, int y)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+    return unpack_tile(
+        floor_state.current_floor.room_tiles[get_room_tile_index(x, y)],
+        get_room(x / ROOM_TILE_WIDTH, y / ROOM_TILE_HEIGHT));
 }
 
 
-const Tile & get_room_tile(int x, int y)
+const Packed_Tile * get_packed_room_tiles()
 {
-    return *array_2d_at(current_floor.room_tiles, current_floor.room_tiles_width, x, y);
+    return get_world().floor_manager.current_floor.room_tiles;
 }
 
 
 void iterate_rooms(const function<void(int, int, int &)> & callback)
 {
+    Floor & current_floor = get_world().floor_manager.current_floor;
     iterate_array_2d(current_floor.rooms, current_floor.size, current_floor.size, callback);
 }
 
 
-void iterate_room_tiles(const function<void(int, int, Tile &)> & callback)
+void iterate_room_tiles(const function<void(int, int, const Tile &)> & callback)
 {
-    iterate_array_2d(
-        current_floor.room_tiles,
-        current_floor.size * ROOM_TILE_WIDTH,
-        current_floor.size * ROOM_TILE_HEIGHT,
-        callback);
+    iterate_rooms([&](int room_x, int room_y, int & room) -> void
+    {
+        iterate_room_tiles(room_x, room_y, false, [&](int x, int y, Packed_Tile & packed_tile) -> void
+        {
+            callback(x, y, unpack_tile(packed_tile, room));
+        });
+    });
 }
 
 
 int get_floor_size()
 {
-    return current_floor.size;
+    return get_world().floor_manager.current_floor.size;
 }
 
 
@@ -730,7 +1617,7 @@ const glm::vec3 & get_room_tile_unit_size()
 
 int get_max_room_id()
 {
-    return max_room_id;
+    return get_world().floor_manager.max_room_id;
 }
 
 
@@ -742,7 +1629,8 @@ int get_spawn_room_id()
 
 void add_enemy(int room_id, Entity enemy)
 {
-    vector<Entity> & enemies = room_enemies[room_id];
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    vector<Entity> & enemies = floor_state.room_enemies[room_id];
 
     if (contains(enemies, enemy))
     {
@@ -755,7 +1643,8 @@ void add_enemy(int room_id, Entity enemy)
 
 void remove_enemy(int room_id, Entity enemy)
 {
-    vector<Entity> & enemies = room_enemies[room_id];
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    vector<Entity> & enemies = floor_state.room_enemies[room_id];
 
     if (!contains(enemies, enemy))
     {
@@ -771,9 +1660,25 @@ void remove_enemy(int room_id, Entity enemy)
 }
 
 
+const vector<Entity> & get_room_enemies(int room_id)
+{
+    return get_world().floor_manager.room_enemies[room_id];
+}
+
+
+int get_room_enemy_count(int room_id)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+    return contains_key(floor_state.room_enemies, room_id) ? floor_state.room_enemies.at(room_id).size() : 0;
+}
+
+
 int get_enemy_room(Entity enemy)
 {
-    for (const auto & room_enemy_data : room_enemies)
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+    for (const auto & room_enemy_data : floor_state.room_enemies)
     {
         for (const Entity room_enemy : room_enemy_data.second)
         {
@@ -804,6 +1709,64 @@ vec2 get_room_tile_position(const ivec2 & coordinates)
 }
 
 
+void occupy_floor_tile(Entity occupant, const ivec2 & coordinates)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    release_floor_tile(occupant);
+    add_floor_tile_occupant(coordinates);
+    floor_state.floor_tile_occupants[occupant] = coordinates;
+}
+
+
+bool occupy_random_floor_tile(Entity occupant, int room, ivec2 & coordinates)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+    release_floor_tile(occupant);
+
+    if (room < 0 || room >= (int)floor_state.room_floor_tiles.size())
+    {
+        return false;
+    }
+
+
+    const Room_Floor_Tiles & room_floor_tile_range = floor_state.room_floor_tiles[room];
+
+    if (room_floor_tile_range.free_count == 0)
+    {
+        return false;
+    }
+
+
+    coordinates = floor_state.floor_tiles[room_floor_tile_range.begin + random(0, room_floor_tile_range.free_count)];
+    occupy_floor_tile(occupant, coordinates);
+    return true;
+}
+
+
+void release_floor_tile(Entity occupant)
+{
+    Floor_Manager_State & floor_state = get_world().floor_manager;
+
+
+    // Occupants tracked for a previous floor are ignored, as destroy_floor() has already cleared them.
+    if (!contains_key(floor_state.floor_tile_occupants, occupant))
+    {
+        return;
+    }
+
+    remove_floor_tile_occupant(floor_state.floor_tile_occupants.at(occupant));
+    remove(floor_state.floor_tile_occupants, occupant);
+}
+
+
+int get_free_floor_tile_count(int room)
+{
+    const vector<Room_Floor_Tiles> & room_floor_tiles = get_world().floor_manager.room_floor_tiles;
+
+    return room < 0 || room >= (int)room_floor_tiles.size() ? 0 : room_floor_tiles[room].free_count;
+}
+
+
 void add_floor_generated_handler(const string & id, const function<void()> & handler)
 {
     floor_generated_handlers[id] = handler;
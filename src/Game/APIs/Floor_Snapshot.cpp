@@ -0,0 +1,477 @@
+#include "Game/APIs/Floor_Snapshot.hpp"
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <glm/glm.hpp>
+#include "Cpp_Utils/Map.hpp"
+#include "Cpp_Utils/String.hpp"
+
+#include "Game/APIs/Floor_Manager.hpp"
+#include "Game/APIs/Enemy_Manager.hpp"
+#include "Game/Systems/Item.hpp"
+
+
+using std::string;
+using std::vector;
+using std::ifstream;
+using std::ofstream;
+using std::ios;
+using std::runtime_error;
+using std::memcmp;
+using std::memcpy;
+using std::strncpy;
+using std::find;
+using std::max;
+
+// glm/glm.hpp
+using glm::vec3;
+
+// Cpp_Utils/Map.hpp
+using Cpp_Utils::contains_key;
+
+// Cpp_Utils/String.hpp
+using Cpp_Utils::to_string;
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Snapshots are a fixed header followed by sections of fixed-size records. Every section starts at an 8-byte aligned
+// offset so a snapshot can be used straight from a mapped file without any parsing.
+enum Floor_Snapshot_Sections
+{
+    ROOMS,
+    ROOM_OBSTACLE_LAYOUTS,
+    ROOM_TILES,
+    ROOM_STATES,
+    ENEMY_LAYOUTS,
+    ITEMS,
+    SECTION_COUNT,
+};
+
+
+struct Floor_Snapshot_Section
+{
+    uint32_t offset;
+    uint32_t size;
+};
+
+
+struct Floor_Snapshot_Header
+{
+    char magic[4];
+    uint32_t version;
+    int32_t floor_size;
+    int32_t room_tile_width;
+    int32_t room_tile_height;
+    int32_t max_room_id;
+    Floor_Snapshot_Section sections[SECTION_COUNT];
+};
+
+
+// Indexed by room id; enemies is a bitmask of Enemies values and layouts index into the ENEMY_LAYOUTS section.
+struct Room_State_Record
+{
+    uint32_t enemies;
+    uint32_t cleared;
+    uint32_t layouts_offset;
+    uint32_t layout_count;
+};
+
+
+struct Item_Record
+{
+    char name[32];
+    int32_t room;
+    float x;
+    float y;
+    float z;
+};
+
+
+// A snapshot's header and its sections, mapped in place from the buffer it was read into.
+struct Floor_Snapshot
+{
+    Floor_Snapshot_Header header;
+    const int32_t * rooms;
+    const int32_t * room_obstacle_layouts;
+    const Packed_Tile * room_tiles;
+    const Room_State_Record * room_states;
+    const int32_t * enemy_layouts;
+    uint32_t enemy_layout_count;
+    const Item_Record * items;
+    uint32_t item_count;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const char MAGIC[4] { 'G', 'F', 'L', 'R' };
+static const uint32_t VERSION = 2;
+static const uint32_t SECTION_ALIGNMENT = 8;
+
+
+// Far beyond any floor the game generates, but small enough that a floor's room and tile counts can't overflow.
+static const int32_t MAX_FLOOR_SIZE = 1024;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint32_t align_offset(uint32_t offset)
+{
+    return (offset + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+
+template<typename T>
+static void write_section(
+    vector<char> & buffer,
+    Floor_Snapshot_Header & header,
+    Floor_Snapshot_Sections section,
+    const vector<T> & records)
+{
+    const uint32_t offset = align_offset(buffer.size());
+    const uint32_t size = records.size() * sizeof(T);
+    header.sections[section] = { offset, size };
+    buffer.resize(offset + size);
+
+    if (size > 0)
+    {
+        memcpy(&buffer[offset], records.data(), size);
+    }
+}
+
+
+template<typename T>
+static const T * read_section(
+    const vector<char> & buffer,
+    const Floor_Snapshot_Header & header,
+    Floor_Snapshot_Sections section,
+    uint64_t expected_count)
+{
+    const Floor_Snapshot_Section & snapshot_section = header.sections[section];
+
+    if (snapshot_section.offset % SECTION_ALIGNMENT != 0 ||
+        snapshot_section.offset + (uint64_t)snapshot_section.size > buffer.size() ||
+        snapshot_section.size != expected_count * sizeof(T))
+    {
+        throw runtime_error("ERROR: floor snapshot section " + to_string(section) + " is corrupt!");
+    }
+
+    return (const T *)&buffer[snapshot_section.offset];
+}
+
+
+// Reads and validates a snapshot into buffer, mapping its sections in place.
+static Floor_Snapshot read_floor_snapshot(const string & path, vector<char> & buffer)
+{
+    ifstream file(path, ios::binary | ios::ate);
+
+    if (!file)
+    {
+        throw runtime_error("ERROR: failed to open floor snapshot \"" + path + "\"!");
+    }
+
+    buffer.resize(file.tellg());
+    file.seekg(0);
+
+    if (buffer.size() < sizeof(Floor_Snapshot_Header) || !file.read(buffer.data(), buffer.size()))
+    {
+        throw runtime_error("ERROR: failed to read floor snapshot \"" + path + "\"!");
+    }
+
+
+    // Validate header.
+    Floor_Snapshot snapshot;
+    Floor_Snapshot_Header & header = snapshot.header;
+    memcpy(&header, buffer.data(), sizeof(header));
+
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        throw runtime_error("ERROR: \"" + path + "\" is not a floor snapshot!");
+    }
+
+    if (header.version != VERSION)
+    {
+        throw runtime_error(
+            "ERROR: floor snapshot \"" + path + "\" has version " + to_string(header.version) + ", expected " +
+            to_string(VERSION) + "!");
+    }
+
+    if (header.room_tile_width != get_room_tile_width() ||
+        header.room_tile_height != get_room_tile_height() ||
+        header.floor_size <= 0 ||
+        header.max_room_id <= get_spawn_room_id())
+    {
+        throw runtime_error("ERROR: floor snapshot \"" + path + "\" does not match the current room dimensions!");
+    }
+
+
+    // Every room takes up at least one cell of the floor, so there can't be more rooms than cells.
+    const uint64_t room_count = (uint64_t)header.floor_size * header.floor_size;
+
+    if (header.floor_size > MAX_FLOOR_SIZE || (uint64_t)header.max_room_id >= room_count)
+    {
+        throw runtime_error("ERROR: floor snapshot \"" + path + "\" has a corrupt floor size!");
+    }
+
+
+    // Map sections.
+    const int max_room_id = header.max_room_id;
+    const uint64_t room_tile_count = room_count * header.room_tile_width * header.room_tile_height;
+    snapshot.rooms = read_section<int32_t>(buffer, header, ROOMS, room_count);
+    snapshot.room_obstacle_layouts = read_section<int32_t>(buffer, header, ROOM_OBSTACLE_LAYOUTS, room_count);
+    snapshot.room_tiles = read_section<Packed_Tile>(buffer, header, ROOM_TILES, room_tile_count);
+    snapshot.room_states = read_section<Room_State_Record>(buffer, header, ROOM_STATES, (uint64_t)max_room_id + 1);
+    snapshot.enemy_layout_count = header.sections[ENEMY_LAYOUTS].size / sizeof(int32_t);
+    snapshot.enemy_layouts = read_section<int32_t>(buffer, header, ENEMY_LAYOUTS, snapshot.enemy_layout_count);
+    snapshot.item_count = header.sections[ITEMS].size / sizeof(Item_Record);
+    snapshot.items = read_section<Item_Record>(buffer, header, ITEMS, snapshot.item_count);
+
+
+    // Room ids index the floor manager's per-room state, so every one must be a room the header accounts for, and the
+    // highest must be the header's, as the floor manager takes its max room id from the rooms.
+    int32_t highest_room = 0;
+
+    for (uint64_t i = 0; i < room_count; i++)
+    {
+        const int32_t room = snapshot.rooms[i];
+
+        if (room < 0 || room > max_room_id)
+        {
+            throw runtime_error("ERROR: floor snapshot \"" + path + "\" has corrupt rooms!");
+        }
+
+        highest_room = max(highest_room, room);
+    }
+
+    if (highest_room != max_room_id)
+    {
+        throw runtime_error("ERROR: floor snapshot \"" + path + "\" has corrupt rooms!");
+    }
+
+    for (uint64_t i = 0; i < room_tile_count; i++)
+    {
+        if (snapshot.room_tiles[i].type > (uint8_t)Tile_Types::NONE)
+        {
+            throw runtime_error("ERROR: floor snapshot \"" + path + "\" has corrupt room tiles!");
+        }
+    }
+
+    for (int room = 0; room <= max_room_id; room++)
+    {
+        const Room_State_Record & room_state = snapshot.room_states[room];
+
+        if (!room_state.cleared &&
+            room_state.layouts_offset + (uint64_t)room_state.layout_count > snapshot.enemy_layout_count)
+        {
+            throw runtime_error("ERROR: floor snapshot \"" + path + "\" has corrupt enemy layouts!");
+        }
+    }
+
+    for (uint32_t i = 0; i < snapshot.item_count; i++)
+    {
+        if (snapshot.items[i].room < get_spawn_room_id() || snapshot.items[i].room > max_room_id)
+        {
+            throw runtime_error("ERROR: floor snapshot \"" + path + "\" has corrupt items!");
+        }
+    }
+
+    return snapshot;
+}
+
+
+// Restores the floor layout and the enemy groups of rooms that were not cleared, without creating any entities.
+static void restore_floor_layout(const Floor_Snapshot & snapshot)
+{
+    Enemy_Groups enemy_groups;
+    load_floor_layout(snapshot.header.floor_size, snapshot.rooms, snapshot.room_obstacle_layouts, snapshot.room_tiles);
+
+    for (int room = 0; room <= snapshot.header.max_room_id; room++)
+    {
+        const Room_State_Record & room_state = snapshot.room_states[room];
+
+        if (room_state.cleared)
+        {
+            continue;
+        }
+
+        Enemy_Group & enemy_group = enemy_groups[room];
+
+        for (uint32_t enemy = 0; enemy < (uint32_t)Enemies::NONE; enemy++)
+        {
+            if (room_state.enemies & (1u << enemy))
+            {
+                enemy_group.enemies.push_back((Enemies)enemy);
+            }
+        }
+
+        enemy_group.layouts.assign(
+            snapshot.enemy_layouts + room_state.layouts_offset,
+            snapshot.enemy_layouts + room_state.layouts_offset + room_state.layout_count);
+    }
+
+    set_enemy_groups(enemy_groups);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void save_floor_snapshot(const string & path)
+{
+    const int floor_size = get_floor_size();
+    const int max_room_id = get_max_room_id();
+    const Enemy_Groups & enemy_groups = get_enemy_groups();
+    vector<int32_t> rooms;
+    vector<int32_t> room_obstacle_layouts;
+    vector<Packed_Tile> room_tiles;
+    vector<Room_State_Record> room_states(max_room_id + 1);
+    vector<int32_t> enemy_layouts;
+    vector<Item_Record> items;
+
+
+    // Rooms are iterated column-major, so store them at their row-major index.
+    rooms.resize(floor_size * floor_size);
+    room_obstacle_layouts.resize(floor_size * floor_size);
+
+    iterate_rooms([&](int x, int y, const int & room) -> void
+    {
+        const int index = (y * floor_size) + x;
+        rooms[index] = room;
+        room_obstacle_layouts[index] = get_room_obstacle_layout(x, y);
+    });
+
+    // Room tiles are stored in the same packed, room-major layout the floor manager uses, so they can be copied as-is.
+    const Packed_Tile * packed_room_tiles = get_packed_room_tiles();
+
+    room_tiles.assign(
+        packed_room_tiles,
+        packed_room_tiles + (floor_size * floor_size * get_room_tile_width() * get_room_tile_height()));
+
+
+    // Rooms without a live enemy group are cleared, and will not have their enemies respawned when loaded.
+    for (int room = 0; room <= max_room_id; room++)
+    {
+        Room_State_Record & room_state = room_states[room];
+        room_state = { 0, 1, (uint32_t)enemy_layouts.size(), 0 };
+
+        if (!contains_key(enemy_groups, room))
+        {
+            continue;
+        }
+
+        const Enemy_Group & enemy_group = enemy_groups.at(room);
+        room_state.cleared = 0;
+        room_state.layout_count = enemy_group.layouts.size();
+
+        for (const Enemies enemy : enemy_group.enemies)
+        {
+            room_state.enemies |= 1u << (uint32_t)enemy;
+        }
+
+        enemy_layouts.insert(enemy_layouts.end(), enemy_group.layouts.begin(), enemy_group.layouts.end());
+    }
+
+    iterate_items([&](const string & name, int room, const vec3 & position) -> void
+    {
+        Item_Record item {};
+
+        if (name.size() >= sizeof(item.name))
+        {
+            throw runtime_error("ERROR: item name \"" + name + "\" is too long to be stored in a floor snapshot!");
+        }
+
+        strncpy(item.name, name.c_str(), sizeof(item.name));
+        item.room = room;
+        item.x = position.x;
+        item.y = position.y;
+        item.z = position.z;
+        items.push_back(item);
+    });
+
+
+    // Write header and sections.
+    vector<char> buffer(sizeof(Floor_Snapshot_Header));
+    Floor_Snapshot_Header header {};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.floor_size = floor_size;
+    header.room_tile_width = get_room_tile_width();
+    header.room_tile_height = get_room_tile_height();
+    header.max_room_id = max_room_id;
+    write_section(buffer, header, ROOMS, rooms);
+    write_section(buffer, header, ROOM_OBSTACLE_LAYOUTS, room_obstacle_layouts);
+    write_section(buffer, header, ROOM_TILES, room_tiles);
+    write_section(buffer, header, ROOM_STATES, room_states);
+    write_section(buffer, header, ENEMY_LAYOUTS, enemy_layouts);
+    write_section(buffer, header, ITEMS, items);
+    memcpy(&buffer[0], &header, sizeof(header));
+
+    ofstream file(path, ios::binary | ios::trunc);
+
+    if (!file.write(buffer.data(), buffer.size()))
+    {
+        throw runtime_error("ERROR: failed to write floor snapshot to \"" + path + "\"!");
+    }
+}
+
+
+void load_floor_snapshot_layout(const string & path)
+{
+    vector<char> buffer;
+    restore_floor_layout(read_floor_snapshot(path, buffer));
+}
+
+
+void load_floor_snapshot(const string & path)
+{
+    vector<char> buffer;
+    const Floor_Snapshot snapshot = read_floor_snapshot(path, buffer);
+    restore_floor_layout(snapshot);
+
+
+    // Items must lie in the room they were dropped in, which can only be checked once the room layout is restored.
+    for (uint32_t i = 0; i < snapshot.item_count; i++)
+    {
+        const Item_Record & item = snapshot.items[i];
+
+        if (get_room(vec3(item.x, item.y, item.z)) != item.room)
+        {
+            throw runtime_error("ERROR: floor snapshot \"" + path + "\" has an item outside of its room!");
+        }
+    }
+
+    build_floor();
+    spawn_enemies();
+
+
+    // Restore dropped items.
+    for (uint32_t i = 0; i < snapshot.item_count; i++)
+    {
+        const Item_Record & item = snapshot.items[i];
+        const char * item_name_end = find(item.name, item.name + sizeof(item.name), '\0');
+        spawn_item(string(item.name, item_name_end), item.room, vec3(item.x, item.y, item.z));
+    }
+}
+
+
+} // namespace Game
@@ -0,0 +1,145 @@
+#include "Game/APIs/Frame_Arena.hpp"
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+
+using std::vector;
+using std::unique_ptr;
+using std::size_t;
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct Frame_Arena_Block
+{
+    unique_ptr<char[]> memory;
+    size_t size;
+};
+
+
+// Blocks are kept when the arena is reset, so once it has grown to fit a frame's transient containers, later frames
+// allocate nothing.
+struct Frame_Arena
+{
+    vector<Frame_Arena_Block> blocks;
+    int block;
+    size_t offset;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const size_t FRAME_ARENA_BLOCK_SIZE = 64 * 1024;
+
+
+// Each thread gets its own arena, as worlds can be simulated on several threads at once.
+static thread_local Frame_Arena frame_arena;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static size_t align_offset(size_t offset, size_t alignment)
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Frame_Arena_Scope::Frame_Arena_Scope()
+    : mark(get_frame_arena_mark())
+{
+}
+
+
+Frame_Arena_Scope::~Frame_Arena_Scope()
+{
+    rewind_frame_arena(mark);
+}
+
+
+void frame_arena_update()
+{
+    rewind_frame_arena({ 0, 0 });
+}
+
+
+void * allocate_frame_memory(size_t size, size_t alignment)
+{
+    vector<Frame_Arena_Block> & blocks = frame_arena.blocks;
+
+
+    // Move on to the next block that fits the allocation, adding a block when none of the remaining ones do. Skipped
+    // blocks are left unused until the arena is reset.
+    while (frame_arena.block == (int)blocks.size() ||
+           align_offset(frame_arena.offset, alignment) + size > blocks[frame_arena.block].size)
+    {
+        if (frame_arena.block == (int)blocks.size())
+        {
+            const size_t block_size =
+                size + alignment > FRAME_ARENA_BLOCK_SIZE
+                ? size + alignment
+                : FRAME_ARENA_BLOCK_SIZE;
+
+            blocks.push_back({ unique_ptr<char[]>(new char[block_size]), block_size });
+            frame_arena.offset = 0;
+            continue;
+        }
+
+        frame_arena.block++;
+        frame_arena.offset = 0;
+    }
+
+
+    // Block memory comes from new, so it's aligned for any type and offsets only need aligning within the block.
+    const size_t offset = align_offset(frame_arena.offset, alignment);
+    frame_arena.offset = offset + size;
+    return blocks[frame_arena.block].memory.get() + offset;
+}
+
+
+Frame_Arena_Mark get_frame_arena_mark()
+{
+    return { frame_arena.block, frame_arena.offset };
+}
+
+
+void rewind_frame_arena(const Frame_Arena_Mark & mark)
+{
+    frame_arena.block = mark.block;
+    frame_arena.offset = mark.offset;
+}
+
+
+size_t get_frame_arena_capacity()
+{
+    size_t capacity = 0;
+
+    for (const Frame_Arena_Block & block : frame_arena.blocks)
+    {
+        capacity += block.size;
+    }
+
+    return capacity;
+}
+
+
+} // namespace Game
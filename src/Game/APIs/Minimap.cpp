@@ -9,9 +9,9 @@
 #include "Nito/APIs/Scene.hpp"
 #include "Nito/APIs/Graphics.hpp"
 #include "Nito/APIs/Resources.hpp"
-#include "Cpp_Utils/Collection.hpp"
-#include "Cpp_Utils/Vector.hpp"
+#include "Cpp_Utils/Map.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/APIs/Floor_Manager.hpp"
 #include "Game/Systems/Game_Manager.hpp"
 
@@ -22,6 +22,7 @@ using std::map;
 
 // glm/glm.hpp
 using glm::vec3;
+using glm::ivec2;
 
 // Nito/Components.hpp
 using Nito::Transform;
@@ -31,8 +32,6 @@ using Nito::Sprite;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::Component;
-using Nito::get_component;
 
 // Nito/APIs/Scene.hpp
 using Nito::load_blueprint;
@@ -43,11 +42,8 @@ using Nito::get_pixels_per_unit;
 // Nito/APIs/Resources.hpp
 using Nito::get_loaded_texture;
 
-// Cpp_Utils/Collection.hpp
-using Cpp_Utils::for_each;
-
-// Cpp_Utils/Vector.hpp
-using Cpp_Utils::contains;
+// Cpp_Utils/Map.hpp
+using Cpp_Utils::contains_key;
 
 
 namespace Game
@@ -59,13 +55,31 @@ namespace Game
 // Data Structures
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-struct Minimap_Room
+enum class Minimap_Cell_States
+{
+    UNSEEN,
+    SEEN,
+    OCCUPIED,
+    VACANT,
+};
+
+
+struct Minimap_Cell
 {
     int x;
     int y;
-    bool * base_render_flag;
-    vector<bool *> occupied_render_flags;
-    vector<bool *> vacant_render_flags;
+    Minimap_Cell_States state;
+    bool dirty;
+    vector<float> connector_rotations;
+    Sprite * base_sprite;
+    Sprite * overlay_sprite;
+    vector<Sprite *> connector_sprites;
+};
+
+
+struct Minimap_Room
+{
+    vector<int> cells;
 };
 
 
@@ -75,9 +89,18 @@ struct Minimap_Room
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static const string MINIMAP_ROOM_TEXTURE_PATH("resources/textures/ui/minimap_room.png");
+static const string MINIMAP_ROOM_VACANT_TEXTURE_PATH("resources/textures/ui/minimap_room_vacant.png");
+static const string MINIMAP_ROOM_BASE_TEXTURE_PATH("resources/textures/ui/minimap_room_base.png");
+static const string MINIMAP_ROOM_CONNECTOR_TEXTURE_PATH("resources/textures/ui/minimap_room_connector.png");
+
+static const string MINIMAP_ROOM_CONNECTOR_VACANT_TEXTURE_PATH(
+    "resources/textures/ui/minimap_room_connector_vacant.png");
+
 static const string MINIMAP_ROOM_CHANGE_HANDLER_ID("minimap");
 static vec3 room_texture_offset;
-static map<int, vector<Minimap_Room>> minimap_room_groups;
+static vector<Minimap_Cell> minimap_cells;
+static map<int, Minimap_Room> minimap_rooms;
+static vector<int> dirty_minimap_cells;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -85,123 +108,136 @@ static map<int, vector<Minimap_Room>> minimap_room_groups;
 // Utilities
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static void generate_minimap_tile(
-    const vec3 & position,
-    const string & texture_path,
-    bool ** render_flag,
-    float rotation = 0.0f)
+static Sprite * generate_minimap_tile(const vec3 & position, const string & texture_path, float rotation = 0.0f)
 {
     Entity minimap_tile = load_blueprint("minimap_tile");
     const int floor_offset = get_floor_size() - 1;
-    auto sprite = (Sprite *)get_component(minimap_tile, "sprite");
+    auto sprite = component<Sprite>(minimap_tile);
     sprite->texture_path = texture_path;
-    *render_flag = &sprite->render;
 
-    ((UI_Transform *)get_component(minimap_tile, "ui_transform"))->position =
+    component<UI_Transform>(minimap_tile)->position =
         (position * room_texture_offset) -
         (room_texture_offset * vec3(floor_offset, floor_offset, 0.0f)) -
-        (room_texture_offset * ((Dimensions *)get_component(minimap_tile, "dimensions"))->origin) -
+        (room_texture_offset * component<Dimensions>(minimap_tile)->origin) -
         vec3(0.1f, 0.1f, 0);
 
-    ((Transform *)get_component(minimap_tile, "transform"))->rotation = rotation;
+    component<Transform>(minimap_tile)->rotation = rotation;
+    return sprite;
 }
 
 
-static void generate_room_connectors(
-    int x,
-    int y,
-    float rotation,
-    vector<bool *> & occupied_render_flags,
-    vector<bool *> & vacant_render_flags)
+static void set_minimap_cell_state(int cell_index, Minimap_Cell_States state)
 {
-    static const string ROOM_CONNECTOR_TEXTURE_PATH = "resources/textures/ui/minimap_room_connector.png";
-    static const string ROOM_CONNECTOR_VACANT_TEXTURE_PATH = "resources/textures/ui/minimap_room_connector_vacant.png";
-
-    bool * room_connector_render_flag;
-    bool * room_connector_vacant_render_flag;
-
-    generate_minimap_tile(
-        vec3(x, y, -1.0f),
-        ROOM_CONNECTOR_TEXTURE_PATH,
-        &room_connector_render_flag,
-        rotation);
-
-    generate_minimap_tile(
-        vec3(x, y, -1.0f),
-        ROOM_CONNECTOR_VACANT_TEXTURE_PATH,
-        &room_connector_vacant_render_flag,
-        rotation);
-
-    occupied_render_flags.push_back(room_connector_render_flag);
-    vacant_render_flags.push_back(room_connector_vacant_render_flag);
-}
+    Minimap_Cell & minimap_cell = minimap_cells[cell_index];
+
+    if (minimap_cell.state == state)
+    {
+        return;
+    }
 
+    minimap_cell.state = state;
 
-static void set_render_flags(const vector<bool *> & render_flags, bool value)
-{
-    for (bool * render_flag : render_flags)
+    if (!minimap_cell.dirty)
     {
-        *render_flag = value;
+        minimap_cell.dirty = true;
+        dirty_minimap_cells.push_back(cell_index);
     }
 }
 
 
 static void occupy_room(int room)
 {
-    for (Minimap_Room & minimap_room : minimap_room_groups[room])
+    if (!contains_key(minimap_rooms, room))
     {
-        // Ensure base is on.
-        *minimap_room.base_render_flag = true;
+        return;
+    }
 
 
-        // Ensure neighboring bases are on.
-        int x = minimap_room.x;
-        int y = minimap_room.y;
+    const Minimap_Room & minimap_room = minimap_rooms.at(room);
 
-        vector<int> neighbor_rooms
-        {
-            get_room(x, y - 1),
-            get_room(x - 1, y),
-            get_room(x, y + 1),
-            get_room(x + 1, y),
-        };
+    for (const int cell_index : minimap_room.cells)
+    {
+        set_minimap_cell_state(cell_index, Minimap_Cell_States::OCCUPIED);
+    }
 
-        vector<int> flagged_rooms;
 
-        for (int neighbor_room : neighbor_rooms)
+    // Ensure neighboring rooms are at least seen.
+    for (const int neighbor_room : get_room_neighbors(room))
+    {
+        for (const int cell_index : minimap_rooms.at(neighbor_room).cells)
         {
-            // Don't enable base flag for empty/out-of-bounds rooms, the same room as this, or a room that's already had
-            // its base flag set.
-            if (neighbor_room <= 0 ||
-                neighbor_room == room ||
-                contains(flagged_rooms, neighbor_room))
-            {
-                continue;
-            }
-
-
-            for (Minimap_Room & minimap_neighbor_room : minimap_room_groups[neighbor_room])
+            if (minimap_cells[cell_index].state == Minimap_Cell_States::UNSEEN)
             {
-                *minimap_neighbor_room.base_render_flag = true;
+                set_minimap_cell_state(cell_index, Minimap_Cell_States::SEEN);
             }
-
-            flagged_rooms.push_back(neighbor_room);
         }
+    }
+}
 
 
-        set_render_flags(minimap_room.occupied_render_flags, true);
-        set_render_flags(minimap_room.vacant_render_flags, false);
+static void vacate_room(int room)
+{
+    if (!contains_key(minimap_rooms, room))
+    {
+        return;
+    }
+
+    for (const int cell_index : minimap_rooms.at(room).cells)
+    {
+        set_minimap_cell_state(cell_index, Minimap_Cell_States::VACANT);
     }
 }
 
 
-static void vacate_room(int room)
+// Only cells whose state changed since the last draw are touched. A cell's tiles are created the first time it's drawn
+// seen, so unexplored parts of the floor never get minimap entities.
+static void draw_dirty_minimap_cells()
 {
-    for (Minimap_Room & minimap_room : minimap_room_groups[room])
+    for (const int cell_index : dirty_minimap_cells)
     {
-        set_render_flags(minimap_room.vacant_render_flags, true);
-        set_render_flags(minimap_room.occupied_render_flags, false);
+        Minimap_Cell & minimap_cell = minimap_cells[cell_index];
+        const Minimap_Cell_States state = minimap_cell.state;
+        minimap_cell.dirty = false;
+
+        if (state == Minimap_Cell_States::UNSEEN && minimap_cell.base_sprite == nullptr)
+        {
+            continue;
+        }
+
+
+        // Generate cell's tiles the first time it is seen.
+        if (minimap_cell.base_sprite == nullptr)
+        {
+            const vec3 base_position(minimap_cell.x, minimap_cell.y, 0.0f);
+            const vec3 overlay_position(minimap_cell.x, minimap_cell.y, -1.0f);
+            minimap_cell.base_sprite = generate_minimap_tile(base_position, MINIMAP_ROOM_BASE_TEXTURE_PATH);
+            minimap_cell.overlay_sprite = generate_minimap_tile(overlay_position, MINIMAP_ROOM_TEXTURE_PATH);
+
+            for (const float connector_rotation : minimap_cell.connector_rotations)
+            {
+                minimap_cell.connector_sprites.push_back(
+                    generate_minimap_tile(overlay_position, MINIMAP_ROOM_CONNECTOR_TEXTURE_PATH, connector_rotation));
+            }
+        }
+
+
+        const bool visited = state == Minimap_Cell_States::OCCUPIED || state == Minimap_Cell_States::VACANT;
+        const bool occupied = state == Minimap_Cell_States::OCCUPIED;
+        minimap_cell.base_sprite->render = state != Minimap_Cell_States::UNSEEN;
+        minimap_cell.overlay_sprite->render = visited;
+        minimap_cell.overlay_sprite->texture_path =
+            occupied ? MINIMAP_ROOM_TEXTURE_PATH : MINIMAP_ROOM_VACANT_TEXTURE_PATH;
+
+        for (Sprite * connector_sprite : minimap_cell.connector_sprites)
+        {
+            connector_sprite->render = visited;
+
+            connector_sprite->texture_path =
+                occupied ? MINIMAP_ROOM_CONNECTOR_TEXTURE_PATH : MINIMAP_ROOM_CONNECTOR_VACANT_TEXTURE_PATH;
+        }
     }
+
+    dirty_minimap_cells.clear();
 }
 
 
@@ -218,86 +254,90 @@ void minimap_api_init()
 }
 
 
-void generate_minimap()
+void generate_minimap_layout()
 {
-    static const string MINIMAP_ROOM_VACANT_TEXTURE_PATH = "resources/textures/ui/minimap_room_vacant.png";
-    static const string MINIMAP_ROOM_BASE_TEXTURE_PATH = "resources/textures/ui/minimap_room_base.png";
+    static const vector<ivec2> NEIGHBOR_OFFSETS
+    {
+        ivec2( 0,-1),
+        ivec2(-1, 0),
+        ivec2( 0, 1),
+        ivec2( 1, 0),
+    };
 
-    game_manager_add_room_change_handler(MINIMAP_ROOM_CHANGE_HANDLER_ID, [](int last_room, int current_room) -> void
+    static const vector<float> CONNECTOR_ROTATIONS
     {
-        vacate_room(last_room);
-        occupy_room(current_room);
-    });
+        0.0f,
+        270.0f,
+        180.0f,
+        90.0f,
+    };
 
+    minimap_cells.clear();
+    minimap_rooms.clear();
+    dirty_minimap_cells.clear();
 
-    // Generate minimap rooms.
     iterate_rooms([&](int x, int y, const int & room) -> void
     {
-        // Don't generate minimap room for empty rooms.
+        // Don't generate minimap cells for empty rooms.
         if (room == 0)
         {
             return;
         }
 
 
-        // Generate minimap room for current room.
-        Minimap_Room minimap_room;
-        minimap_room.x = x;
-        minimap_room.y = y;
-        vector<bool *> & occupied_render_flags = minimap_room.occupied_render_flags;
-        vector<bool *> & vacant_render_flags = minimap_room.vacant_render_flags;
-        bool * room_render_flag;
-        bool * room_vacant_render_flag;
-        generate_minimap_tile(vec3(x, y, 0.0f), MINIMAP_ROOM_BASE_TEXTURE_PATH, &minimap_room.base_render_flag);
-        generate_minimap_tile(vec3(x, y,-1.0f), MINIMAP_ROOM_TEXTURE_PATH, &room_render_flag);
-        generate_minimap_tile(vec3(x, y,-1.0f), MINIMAP_ROOM_VACANT_TEXTURE_PATH, &room_vacant_render_flag);
-        occupied_render_flags.push_back(room_render_flag);
-        vacant_render_flags.push_back(room_vacant_render_flag);
-
+        Minimap_Room & minimap_room = minimap_rooms[room];
+        minimap_room.cells.push_back(minimap_cells.size());
+        minimap_cells.emplace_back();
+        Minimap_Cell & minimap_cell = minimap_cells.back();
+        minimap_cell.x = x;
+        minimap_cell.y = y;
+        minimap_cell.state = Minimap_Cell_States::UNSEEN;
+        minimap_cell.dirty = false;
+        minimap_cell.base_sprite = nullptr;
+        minimap_cell.overlay_sprite = nullptr;
 
-        // Generate room connector for neighboring rooms that are the same as this room.
-        if (get_room(x, y - 1) == room)
+        for (size_t i = 0; i < NEIGHBOR_OFFSETS.size(); i++)
         {
-            generate_room_connectors(x, y, 0.0f, occupied_render_flags, vacant_render_flags);
-        }
+            const ivec2 & neighbor_offset = NEIGHBOR_OFFSETS[i];
+            const int neighbor_room = get_room(x + neighbor_offset.x, y + neighbor_offset.y);
 
-        if (get_room(x - 1, y) == room)
-        {
-            generate_room_connectors(x, y, 270.0f, occupied_render_flags, vacant_render_flags);
-        }
 
-        if (get_room(x, y + 1) == room)
-        {
-            generate_room_connectors(x, y, 180.0f, occupied_render_flags, vacant_render_flags);
-        }
-
-        if (get_room(x + 1, y) == room)
-        {
-            generate_room_connectors(x, y, 90.0f, occupied_render_flags, vacant_render_flags);
+            // Generate room connector for neighboring rooms that are the same as this room.
+            if (neighbor_room == room)
+            {
+                minimap_cell.connector_rotations.push_back(CONNECTOR_ROTATIONS[i]);
+            }
         }
-
-        minimap_room_groups[room].push_back(minimap_room);
     });
+}
 
 
-    // Initialize minimap.
-    for_each(minimap_room_groups, [](int /*room*/, const vector<Minimap_Room> & minimap_room_group) -> void
+void generate_minimap()
+{
+    game_manager_add_room_change_handler(MINIMAP_ROOM_CHANGE_HANDLER_ID, [](int last_room, int current_room) -> void
     {
-        for (const Minimap_Room & minimap_room : minimap_room_group)
-        {
-            *minimap_room.base_render_flag = false;
-            set_render_flags(minimap_room.occupied_render_flags, false);
-            set_render_flags(minimap_room.vacant_render_flags, false);
-        }
+        vacate_room(last_room);
+        occupy_room(current_room);
+        draw_dirty_minimap_cells();
     });
 
+    generate_minimap_layout();
     occupy_room(1);
+    draw_dirty_minimap_cells();
+}
+
+
+int get_minimap_room_count()
+{
+    return minimap_cells.size();
 }
 
 
 void destroy_minimap()
 {
-    minimap_room_groups.clear();
+    minimap_cells.clear();
+    minimap_rooms.clear();
+    dirty_minimap_cells.clear();
     game_manager_remove_room_change_handler(MINIMAP_ROOM_CHANGE_HANDLER_ID);
 }
 
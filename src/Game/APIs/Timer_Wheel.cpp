@@ -0,0 +1,243 @@
+#include "Game/APIs/Timer_Wheel.hpp"
+
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include <cmath>
+#include <utility>
+#include "Nito/Engine.hpp"
+#include "Nito/APIs/Window.hpp"
+
+
+using std::vector;
+using std::function;
+using std::uint64_t;
+using std::ceil;
+using std::floor;
+using std::move;
+
+// Nito/Engine.hpp
+using Nito::get_time_scale;
+
+// Nito/APIs/Window.hpp
+using Nito::get_delta_time;
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct Timer
+{
+    function<void()> callback;
+    uint64_t expiry_tick;
+    int generation;
+    bool pending;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const float TICK_DURATION = 1.0f / 128.0f;
+static const int SLOT_BITS = 6;
+static const int SLOT_COUNT = 1 << SLOT_BITS;
+static const int LEVEL_COUNT = 4;
+
+
+// Delays longer than the top level reaches (a day and a half at 128 ticks a second) are clamped to it.
+static const uint64_t MAX_TIMER_TICKS = ((uint64_t)1 << (SLOT_BITS * LEVEL_COUNT)) - 1;
+
+
+static vector<Timer> timers;
+static vector<int> free_timers;
+
+
+// Each level's slots span SLOT_COUNT times as many ticks as the level below's. Timers are placed in the lowest level
+// that reaches their expiry tick and moved down a level when the wheel reaches the start of their slot, so each tick
+// only looks at the timers expiring on it and the odd slot being moved down. Cancelled timers are left in their slot
+// and skipped, as their handles no longer match their timer.
+static vector<Timer_Handle> slots[LEVEL_COUNT][SLOT_COUNT];
+
+static vector<Timer_Handle> expiring_timers;
+static uint64_t current_tick = 0;
+static float tick_time = 0.0f;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void place_timer(const Timer_Handle & timer_handle)
+{
+    const uint64_t expiry_tick = timers[timer_handle.index].expiry_tick;
+    const uint64_t ticks = expiry_tick - current_tick;
+    int level = 0;
+
+    while (level < LEVEL_COUNT - 1 && (ticks >> (SLOT_BITS * (level + 1))) > 0)
+    {
+        level++;
+    }
+
+    slots[level][(expiry_tick >> (SLOT_BITS * level)) & (SLOT_COUNT - 1)].push_back(timer_handle);
+}
+
+
+static void free_timer(int index)
+{
+    Timer & timer = timers[index];
+    timer.callback = nullptr;
+    timer.pending = false;
+    free_timers.push_back(index);
+}
+
+
+static void advance_tick()
+{
+    current_tick++;
+
+
+    // Move timers down from each level whose slot the wheel has reached the start of. Higher levels' slots only start
+    // where a lower level wraps around, so they don't need checking once a level hasn't.
+    for (int level = 1; level < LEVEL_COUNT; level++)
+    {
+        const int level_shift = SLOT_BITS * level;
+
+        if ((current_tick & (((uint64_t)1 << level_shift) - 1)) != 0)
+        {
+            break;
+        }
+
+        vector<Timer_Handle> & slot = slots[level][(current_tick >> level_shift) & (SLOT_COUNT - 1)];
+
+        for (const Timer_Handle & timer_handle : slot)
+        {
+            if (is_timer_pending(timer_handle))
+            {
+                place_timer(timer_handle);
+            }
+        }
+
+        slot.clear();
+    }
+
+
+    // Expired timers are freed before their callbacks run so callbacks can schedule their own follow-up timers. The
+    // slot is swapped out first, as those follow-ups can't land in it but can resize the slots around it.
+    expiring_timers.swap(slots[0][current_tick & (SLOT_COUNT - 1)]);
+
+    for (const Timer_Handle & timer_handle : expiring_timers)
+    {
+        if (!is_timer_pending(timer_handle))
+        {
+            continue;
+        }
+
+        const function<void()> callback = move(timers[timer_handle.index].callback);
+        free_timer(timer_handle.index);
+
+        if (callback)
+        {
+            callback();
+        }
+    }
+
+    expiring_timers.clear();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void timer_wheel_update()
+{
+    // Timers run on game time, so they stop while the game is paused.
+    timer_wheel_advance(get_delta_time() * get_time_scale());
+}
+
+
+void timer_wheel_advance(float time)
+{
+    // Whole ticks are taken out at once, as subtracting one tick at a time stops changing large times once a tick is
+    // smaller than their precision.
+    tick_time += time;
+    const float ticks = floor(tick_time / TICK_DURATION);
+    tick_time -= ticks * TICK_DURATION;
+
+    for (uint64_t tick = 0; tick < (uint64_t)ticks; tick++)
+    {
+        advance_tick();
+    }
+}
+
+
+Timer_Handle schedule_timer(float delay, const function<void()> & callback)
+{
+    // Timers expire on the first tick at or after their delay has passed, and never on the current tick, which may be
+    // expiring timers as this one is scheduled.
+    const float expiry_ticks = ceil((tick_time + delay) / TICK_DURATION);
+
+    const uint64_t ticks =
+        expiry_ticks < 1.0f ? 1 :
+        expiry_ticks > MAX_TIMER_TICKS ? MAX_TIMER_TICKS :
+        (uint64_t)expiry_ticks;
+
+    int index;
+
+    if (free_timers.empty())
+    {
+        index = timers.size();
+        timers.push_back({ nullptr, 0, 0, false });
+    }
+    else
+    {
+        index = free_timers.back();
+        free_timers.pop_back();
+    }
+
+
+    // Generations start at 1, so value-initialized handles never match a timer.
+    Timer & timer = timers[index];
+    timer.callback = callback;
+    timer.expiry_tick = current_tick + ticks;
+    timer.generation++;
+    timer.pending = true;
+
+    const Timer_Handle timer_handle { index, timer.generation };
+    place_timer(timer_handle);
+    return timer_handle;
+}
+
+
+void cancel_timer(const Timer_Handle & timer_handle)
+{
+    if (is_timer_pending(timer_handle))
+    {
+        free_timer(timer_handle.index);
+    }
+}
+
+
+bool is_timer_pending(const Timer_Handle & timer_handle)
+{
+    if (timer_handle.index < 0 || timer_handle.index >= (int)timers.size())
+    {
+        return false;
+    }
+
+    const Timer & timer = timers[timer_handle.index];
+    return timer.pending && timer.generation == timer_handle.generation;
+}
+
+
+} // namespace Game
@@ -0,0 +1,106 @@
+#include "Game/APIs/Update_Profiler.hpp"
+
+#include <deque>
+#include <string>
+#include <chrono>
+#include <functional>
+
+#include "Game/APIs/Allocation_Tracker.hpp"
+
+
+using std::deque;
+using std::string;
+using std::function;
+using std::chrono::steady_clock;
+using std::chrono::duration;
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Kept in the order handlers were first called, which is the order they run in, and never moved so wrapped handlers
+// can hold onto their profiles.
+static deque<Update_Profile> update_profiles;
+
+static bool profiling_updates = false;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+Update_Profile & get_update_profile(const string & name)
+{
+    for (Update_Profile & update_profile : update_profiles)
+    {
+        if (update_profile.name == name)
+        {
+            return update_profile;
+        }
+    }
+
+    update_profiles.push_back({ name, 0.0, 0, 0, 0 });
+    return update_profiles.back();
+}
+
+
+void run_profiled_update_handler(Update_Profile & update_profile, void (* handler)())
+{
+    if (!profiling_updates)
+    {
+        handler();
+        return;
+    }
+
+    const Allocation_Counts start_counts = get_allocation_counts();
+    const steady_clock::time_point start_time = steady_clock::now();
+    handler();
+    update_profile.total_time += duration<double>(steady_clock::now() - start_time).count();
+    const Allocation_Counts end_counts = get_allocation_counts();
+    update_profile.sample_count++;
+    update_profile.allocation_count += end_counts.allocation_count - start_counts.allocation_count;
+    update_profile.allocated_bytes += end_counts.allocated_bytes - start_counts.allocated_bytes;
+}
+
+
+void set_update_profiling(bool update_profiling)
+{
+    profiling_updates = update_profiling;
+}
+
+
+bool is_update_profiling()
+{
+    return profiling_updates;
+}
+
+
+void reset_update_profiles()
+{
+    for (Update_Profile & update_profile : update_profiles)
+    {
+        update_profile.total_time = 0.0;
+        update_profile.sample_count = 0;
+        update_profile.allocation_count = 0;
+        update_profile.allocated_bytes = 0;
+    }
+}
+
+
+void iterate_update_profiles(const function<void(const Update_Profile &)> & callback)
+{
+    for (const Update_Profile & update_profile : update_profiles)
+    {
+        callback(update_profile);
+    }
+}
+
+
+} // namespace Game
@@ -1,29 +1,35 @@
 #include "Game/Systems/Boss.hpp"
 
+#include <map>
 #include <vector>
 #include <string>
-#include <deque>
+#include <cmath>
 #include <stdexcept>
 #include <algorithm>
 #include <glm/glm.hpp>
-#include <glm/gtx/vector_angle.hpp>
 #include "Nito/Components.hpp"
 #include "Nito/Engine.hpp"
 #include "Nito/APIs/Scene.hpp"
-#include "Nito/APIs/Window.hpp"
+#include "Cpp_Utils/Map.hpp"
 #include "Cpp_Utils/Collection.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Utilities.hpp"
 #include "Game/Components.hpp"
 #include "Game/APIs/Floor_Manager.hpp"
+#include "Game/APIs/Timer_Wheel.hpp"
+#include "Game/APIs/Bullet_Patterns.hpp"
 #include "Game/Systems/Game_Manager.hpp"
+#include "Game/Systems/Depth_Handler.hpp"
 
 
+using std::map;
 using std::vector;
 using std::string;
-using std::deque;
 using std::runtime_error;
 using std::fill;
+using std::sqrt;
+using std::atan2;
 
 // glm/glm.hpp
 using glm::vec3;
@@ -33,12 +39,8 @@ using glm::distance;
 using glm::length;
 using glm::degrees;
 
-// glm/gtx/vector_angle.hpp
-using glm::orientedAngle;
-
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 using Nito::flag_entity_for_deletion;
 
 // Nito/Components.hpp
@@ -50,8 +52,8 @@ using Nito::get_time_scale;
 // Nito/APIs/Scene.hpp
 using Nito::load_blueprint;
 
-// Nito/APIs/Window.hpp
-using Nito::get_delta_time;
+// Cpp_Utils/Map.hpp
+using Cpp_Utils::remove;
 
 // Cpp_Utils/Collection.hpp
 using Cpp_Utils::for_each;
@@ -63,29 +65,51 @@ namespace Game
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
-// Data
+// Data Structures
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static const int SEGMENT_COUNT = 7;
+
+
+// Segment data is stored as parallel fixed-size arrays so each pass over a boss' segment chain walks contiguous memory.
+// destinations is a ring buffer of the boss' most recently completed destinations, newest at destinations_head;
+// segment i trails toward the destination i steps behind the newest. fire_step counts the boss' fire timer ticks since
+// its head last fired.
+struct Boss_State
+{
+    vec3 * position;
+    vec3 * look_direction;
+    bool * enemy_enabled;
+    vec2 destination;
+    Timer_Handle fire_timer;
+    int fire_step;
+    Bullet_Emitter head_bullet_emitter;
+    Bullet_Emitter segment_bullet_emitter;
+    int segment_fire_index;
+    int direction_index;
+    int room;
+    int segment_count;
+    int destinations_head;
+    vec2 destinations[SEGMENT_COUNT];
+    Entity segments[SEGMENT_COUNT];
+    Entity segment_connectors[SEGMENT_COUNT];
+    vec3 * segment_positions[SEGMENT_COUNT];
+    vec3 * segment_look_directions[SEGMENT_COUNT];
+    Transform * segment_connector_transforms[SEGMENT_COUNT];
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static const float FIRE_COOLDOWN = 2.0f;
 static const float SEGMENT_FIRE_INTERVAL = FIRE_COOLDOWN / (SEGMENT_COUNT + 1);
-static vec3 * position;
-static vec3 * look_direction;
-static bool * enemy_enabled;
-static vec2 destination(-1);
-static float cooldown;
-static float segment_cooldown;
-static float segment_fire_index;
+static const string HEAD_BULLET_PATTERN = "boss_head";
+static const string SEGMENT_BULLET_PATTERN = "boss_segment";
+static map<Entity, Boss_State> entity_states;
 static float time_scale;
-static int direction_index = 0;
-static int boss_room;
-static vector<Entity> segments;
-static vector<Entity> segment_connectors;
-static vector<vec2 *> segment_destinations;
-static vector<vec3 *> segment_positions;
-static vector<vec3 *> segment_look_directions;
-static vector<Transform *> segment_connector_transforms;
-static deque<vec2> destinations;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -93,311 +117,313 @@ static deque<vec2> destinations;
 // Utilities
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static void update_segments()
+static void find_destination(Boss_State & boss_state)
 {
-    for (int i = 0; i < SEGMENT_COUNT; i++)
+    static const vector<ivec2> DIRECTIONS
     {
-        *segment_destinations[i] = destinations[i];
-    }
-}
-
+        ivec2( 1, 0),
+        ivec2( 0, 1),
+        ivec2(-1, 0),
+        ivec2( 0,-1),
+    };
 
-static const vec3 get_fire_direction_offset(const vec3 & fire_direction, int fire_direction_index)
-{
-    static const float HORIZONTAL_OFFSET = 0.3f;
-    static const float VERTICAL_OFFSET = 0.15f;
+    static const size_t DIRECTION_COUNT = DIRECTIONS.size();
 
-    return fire_direction * ((fire_direction_index % 2 == 0) ? VERTICAL_OFFSET : HORIZONTAL_OFFSET);
-}
+    int & direction_index = boss_state.direction_index;
+    vec2 & destination = boss_state.destination;
+    const ivec2 current_tile_coordinates = get_room_tile_coordinates(*boss_state.position);
 
 
-static void fire_boss_projectile(int fire_direction_index, const vec3 & position)
-{
-    static const vector<vec3> FIRE_DIRECTIONS
+    // Give 1:2 chance to randomly change direction.
+    if (random(0, 3) == 0)
     {
-        vec3( 0, 1, 0),
-        vec3( 1, 0, 0),
-        vec3( 0,-1, 0),
-        vec3(-1, 0, 0),
-    };
+        direction_index = wrap_index(direction_index + (random(0, 2) == 0 ? 1 : -1), DIRECTION_COUNT);
+    }
+
 
-    static const vector<string> TARGET_LAYERS
+    for (size_t count = 0; count < DIRECTION_COUNT; count++)
     {
-        "player",
-    };
+        const ivec2 & direction = DIRECTIONS[direction_index];
 
-    static const string PROJECTILE_NAME("projectile_purple_orb");
-    static const float DURATION = 2.0f;
+        const ivec2 destination_tile_coordinates(
+            current_tile_coordinates.x + direction.x,
+            current_tile_coordinates.y + direction.y);
 
-    const vec3 & fire_direction = FIRE_DIRECTIONS[wrap_index(fire_direction_index, FIRE_DIRECTIONS.size())];
+        const Tile_Types destination_tile_type = get_room_tile(
+            destination_tile_coordinates.x,
+            destination_tile_coordinates.y).type;
 
-    fire_projectile(
-        PROJECTILE_NAME,
-        position + get_fire_direction_offset(fire_direction, fire_direction_index),
-        fire_direction,
-        DURATION,
-        TARGET_LAYERS);
-}
+        if (!is_walkable(destination_tile_type))
+        {
+            direction_index = wrap_index(direction_index + 1, DIRECTION_COUNT);
+            continue;
+        }
 
+        destination = get_room_tile_position(destination_tile_coordinates);
+        break;
+    }
 
-static void fire_boss_projectiles(const vec3 & position, const vec3 & look_direction, bool forward = false)
-{
-    // Don't fire projectile if game is paused.
-    if (time_scale == 0)
+
+    // If destination is still unset, no neighboring tile is navigable meaning the boss is out-of-bounds or surrounded
+    // by non-navigable tiles.
+    if (destination.x == -1)
     {
-        return;
+        throw runtime_error("ERROR: failed to find a navigable neighboring tile from boss' current tile!");
     }
+}
+
+
+static void update_segment_connectors(Boss_State & boss_state)
+{
+    static const int CHAIN_LENGTH = SEGMENT_COUNT + 1;
 
+    const int segment_count = boss_state.segment_count;
+    float chain_xs[CHAIN_LENGTH];
+    float chain_ys[CHAIN_LENGTH];
+    float connector_lengths[SEGMENT_COUNT];
+    float connector_rotations[SEGMENT_COUNT];
 
-    int fire_direction_index =
-        look_direction.y > 0 ? 0 :
-        look_direction.x > 0 ? 1 :
-        look_direction.y < 0 ? 2 :
-        look_direction.x < 0 ? 3 :
-        0;
 
+    // Gather chain positions, starting with the boss' head.
+    chain_xs[0] = boss_state.position->x;
+    chain_ys[0] = boss_state.position->y;
 
-    // Forward
-    if (forward)
+    for (int i = 0; i < segment_count; i++)
     {
-        fire_boss_projectile(fire_direction_index, position);
+        const vec3 & segment_position = *boss_state.segment_positions[i];
+        chain_xs[i + 1] = segment_position.x;
+        chain_ys[i + 1] = segment_position.y;
     }
 
 
-    // Right
-    fire_boss_projectile(fire_direction_index + 1, position);
+    // Each connector spans from a segment to the link ahead of it, rotated relative to (0, 1). atan2 gives the same
+    // angle as orientedAngle() against (0, 1) without normalizing, and is 0 rather than NaN for overlapping links.
+    for (int i = 0; i < segment_count; i++)
+    {
+        const float delta_x = chain_xs[i] - chain_xs[i + 1];
+        const float delta_y = chain_ys[i] - chain_ys[i + 1];
+        connector_lengths[i] = sqrt(delta_x * delta_x + delta_y * delta_y);
+        connector_rotations[i] = degrees(atan2(-delta_x, delta_y));
+    }
 
 
-    // Left
-    fire_boss_projectile(fire_direction_index - 1, position);
+    // Scatter results to connector transforms.
+    for (int i = 0; i < segment_count; i++)
+    {
+        Transform * segment_connector_transform = boss_state.segment_connector_transforms[i];
+        vec3 & segment_connector_position = segment_connector_transform->position;
+        segment_connector_position.x = chain_xs[i + 1];
+        segment_connector_position.y = chain_ys[i + 1];
+        segment_connector_transform->scale.y = connector_lengths[i];
+        segment_connector_transform->rotation = connector_rotations[i];
+    }
 }
 
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//
-// Interface
-//
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void boss_subscribe(Entity entity)
+static void untrack_segments(const Boss_State & boss_state)
 {
-    position = &((Transform *)get_component(entity, "transform"))->position;
-    look_direction = &((Orientation_Handler *)get_component(entity, "orientation_handler"))->look_direction;
-    enemy_enabled = (bool *)get_component(entity, "enemy_enabled");
-    destination = vec2(-1);
-    cooldown = 0.0f;
-    segment_cooldown = SEGMENT_FIRE_INTERVAL;
-    segment_fire_index = 0;
-    direction_index = 0;
-    boss_room = get_max_room_id();
-
-
-    // Remove boss entity flags from game manager when boss dies.
-    ((Health *)get_component(entity, "health"))->death_handlers["boss"] = [&]() -> void
-    {
-        // Track segment entity flags.
-        for (const Entity segment : segments)
-        {
-            game_manager_untrack_render_flag(boss_room, segment);
-            game_manager_untrack_collider_enabled_flag(boss_room, segment);
-        }
+    const int room = boss_state.room;
 
-        for (const Entity segment : segment_connectors)
-        {
-            game_manager_untrack_render_flag(boss_room, segment);
-        }
-    };
+    for (int i = 0; i < boss_state.segment_count; i++)
+    {
+        const Entity segment = boss_state.segments[i];
+        game_manager_untrack_render_flag(room, segment);
+        game_manager_untrack_collider_enabled_flag(room, segment);
+        game_manager_untrack_render_flag(room, boss_state.segment_connectors[i]);
+    }
 }
 
 
-void boss_unsubscribe(Entity /*entity*/)
+// The boss' head fires every FIRE_COOLDOWN, with its segments taking turns to fire at each SEGMENT_FIRE_INTERVAL in
+// between.
+static void fire_boss(Entity entity)
 {
-    position = nullptr;
-    look_direction = nullptr;
-    for_each(segments, flag_entity_for_deletion);
-    for_each(segment_connectors, flag_entity_for_deletion);
-    segments.clear();
-    segment_connectors.clear();
-    segment_destinations.clear();
-    segment_positions.clear();
-    segment_look_directions.clear();
-    segment_connector_transforms.clear();
-    destinations.clear();
-}
+    Boss_State & boss_state = entity_states.at(entity);
 
 
-void boss_update()
-{
-    static const vector<ivec2> DIRECTIONS
+    // Stop firing while the boss is disabled, leaving update_boss to pick up where it left off once it's enabled.
+    if (!*boss_state.enemy_enabled)
     {
-        ivec2( 1, 0),
-        ivec2( 0, 1),
-        ivec2(-1, 0),
-        ivec2( 0,-1),
-    };
+        return;
+    }
 
-    static const size_t DIRECTION_COUNT = DIRECTIONS.size();
 
+    const int segment_count = boss_state.segment_count;
+    int & fire_step = boss_state.fire_step;
+    int & segment_fire_index = boss_state.segment_fire_index;
 
-    // No entity subscribed.
-    if (position == nullptr)
+    if (fire_step == 0)
     {
-        return;
+        emit_bullet_pattern(
+            HEAD_BULLET_PATTERN,
+            boss_state.head_bullet_emitter,
+            *boss_state.position,
+            *boss_state.look_direction);
+    }
+    else if (segment_count > 0)
+    {
+        emit_bullet_pattern(
+            SEGMENT_BULLET_PATTERN,
+            boss_state.segment_bullet_emitter,
+            *boss_state.segment_positions[segment_fire_index],
+            *boss_state.segment_look_directions[segment_fire_index]);
+
+        segment_fire_index = wrap_index(segment_fire_index + 1, segment_count);
     }
 
+    fire_step = wrap_index(fire_step + 1, SEGMENT_COUNT + 1);
+
+    boss_state.fire_timer = schedule_timer(SEGMENT_FIRE_INTERVAL, [=]() -> void
+    {
+        fire_boss(entity);
+    });
+}
+
 
+static void update_boss(Entity entity, Boss_State & boss_state)
+{
     // Boss is disabled.
-    if (!*enemy_enabled)
+    if (!*boss_state.enemy_enabled)
     {
         return;
     }
 
 
-    time_scale = get_time_scale();
-    const float delta_time = get_delta_time() * time_scale;
+    vec3 * position = boss_state.position;
+    vec3 * look_direction = boss_state.look_direction;
+    vec2 & destination = boss_state.destination;
+    const int segment_count = boss_state.segment_count;
 
 
     // If destination is unset, search neighboring tiles for a new destination.
     if (destination.x == -1)
     {
-        const ivec2 current_tile_coordinates = get_room_tile_coordinates(*position);
-
-
-        // Give 1:2 chance to randomly change direction.
-        if (random(0, 3) == 0)
-        {
-            direction_index = wrap_index(direction_index + (random(0, 2) == 0 ? 1 : -1), DIRECTION_COUNT);
-        }
-
-
-        for (size_t count = 0; count < DIRECTION_COUNT; count++)
-        {
-            const ivec2 & direction = DIRECTIONS[direction_index];
-
-            const ivec2 destination_tile_coordinates(
-                current_tile_coordinates.x + direction.x,
-                current_tile_coordinates.y + direction.y);
-
-            const Tile_Types destination_tile_type = get_room_tile(
-                destination_tile_coordinates.x,
-                destination_tile_coordinates.y).type;
-
-            if (destination_tile_type != Tile_Types::FLOOR &&
-                destination_tile_type != Tile_Types::NEXT_FLOOR)
-            {
-                direction_index = wrap_index(direction_index + 1, DIRECTION_COUNT);
-                continue;
-            }
-
-            destination = get_room_tile_position(destination_tile_coordinates);
-        }
-
-
-        // If destination is still unset, no neighboring tile is navigable meaning the boss is out-of-bounds or
-        // surrounded by non-navigable tiles.
-        if (destination.x == -1)
-        {
-            throw runtime_error("ERROR: failed to find a navigable neighboring tile from boss' current tile!");
-        }
+        find_destination(boss_state);
     }
 
 
     const vec2 movement = move_entity(*position, *look_direction, destination);
+    set_depth_dirty(entity);
 
 
-    // Boss is close enough to destination or has passed it, so unset destination to be reset next frame.
+    // Boss is close enough to destination or has passed it, so push it as the newest trail destination, overwriting
+    // the oldest, and unset destination to be reset next frame.
     if (distance(destination, (vec2)*position) < length(movement))
     {
-        // Update destinations with completed destination.
-        destinations.push_front(destination);
-        destinations.pop_back();
-
-
-        update_segments();
+        boss_state.destinations_head = wrap_index(boss_state.destinations_head - 1, SEGMENT_COUNT);
+        boss_state.destinations[boss_state.destinations_head] = destination;
         destination = vec2(-1);
     }
 
 
-    // Handle firing.
-    cooldown -= delta_time;
-    segment_cooldown -= delta_time;
-
-
-    if (cooldown <= 0.0f)
+    // Move segments along trail.
+    for (int i = 0; i < segment_count; i++)
     {
-        fire_boss_projectiles(*position, *look_direction, true);
-        cooldown = FIRE_COOLDOWN;
-        segment_cooldown = SEGMENT_FIRE_INTERVAL;
+        move_entity(
+            *boss_state.segment_positions[i],
+            *boss_state.segment_look_directions[i],
+            boss_state.destinations[wrap_index(boss_state.destinations_head + i, SEGMENT_COUNT)]);
+
+        set_depth_dirty(boss_state.segments[i]);
     }
-    else if (segment_cooldown <= 0.0f)
+
+
+    // Start firing once the boss is enabled, unless the game is paused.
+    if (time_scale > 0 && !is_timer_pending(boss_state.fire_timer))
     {
-        fire_boss_projectiles(*segment_positions[segment_fire_index], *segment_look_directions[segment_fire_index]);
-        segment_fire_index = wrap_index(segment_fire_index + 1, SEGMENT_COUNT);
-        segment_cooldown = SEGMENT_FIRE_INTERVAL;
+        fire_boss(entity);
     }
 
 
-    // Update boss segment connectors.
-    static const vec2 BASE_ANGLE_VECTOR(0.0f, 1.0f);
+    update_segment_connectors(boss_state);
+}
 
-    vec3 to_position = *position;
 
-    for (int i = 0; i < SEGMENT_COUNT; i++)
-    {
-        const vec3 from_position = *segment_positions[i];
-        const vec2 to_position_2d = (vec2)to_position;
-        const vec2 from_position_2d = (vec2)from_position;
-        Transform * segment_connector_transform = segment_connector_transforms[i];
-        vec3 & segment_connector_position = segment_connector_transform->position;
-        segment_connector_position.x = from_position.x;
-        segment_connector_position.y = from_position.y;
-        segment_connector_transform->scale.y = distance(to_position_2d, from_position_2d);
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void boss_subscribe(Entity entity)
+{
+    Boss_State & boss_state = entity_states[entity];
+    boss_state.position = &component<Transform>(entity)->position;
+    boss_state.look_direction = &component<Orientation_Handler>(entity)->look_direction;
+    boss_state.enemy_enabled = component<Enemy_Enabled>(entity);
+    boss_state.destination = vec2(-1);
+    boss_state.fire_timer = {};
+    boss_state.fire_step = 0;
+    boss_state.head_bullet_emitter = {};
+    boss_state.segment_bullet_emitter = {};
+    boss_state.segment_fire_index = 0;
+    boss_state.direction_index = 0;
+    boss_state.room = get_max_room_id();
+    boss_state.segment_count = 0;
+    boss_state.destinations_head = 0;
+}
+
 
-        segment_connector_transform->rotation =
-            degrees(orientedAngle(BASE_ANGLE_VECTOR, normalize(to_position_2d - from_position_2d)));
+void boss_unsubscribe(Entity entity)
+{
+    // Bosses are unsubscribed both when they die and when their room is released, so segments are only untracked here.
+    const Boss_State & boss_state = entity_states.at(entity);
+    untrack_segments(boss_state);
+    cancel_timer(boss_state.fire_timer);
 
-        to_position = from_position;
+    for (int i = 0; i < boss_state.segment_count; i++)
+    {
+        flag_entity_for_deletion(boss_state.segments[i]);
+        flag_entity_for_deletion(boss_state.segment_connectors[i]);
     }
+
+    remove(entity_states, entity);
+}
+
+
+void boss_update()
+{
+    time_scale = get_time_scale();
+    for_each(entity_states, update_boss);
 }
 
 
-Entity boss_generate(int room_origin_x, int room_origin_y)
+Entity boss_generate(int room, int room_origin_x, int room_origin_y)
 {
     const Entity boss = load_blueprint("boss");
-    *position = vec3(room_origin_x + 6, room_origin_y + 4, 0) * get_room_tile_unit_size();
+    Boss_State & boss_state = entity_states.at(boss);
+    vec3 & position = *boss_state.position;
+    boss_state.room = room;
+    position = vec3(room_origin_x + 6, room_origin_y + 4, 0) * get_room_tile_unit_size();
 
 
-    // Initialize all destinations to boss' position.
-    destinations.resize(SEGMENT_COUNT);
-    fill(destinations.begin(), destinations.end(), *position);
+    // Initialize all trail destinations to boss' position.
+    fill(boss_state.destinations, boss_state.destinations + SEGMENT_COUNT, (vec2)position);
 
 
     // Create boss segments.
     for (int i = 0; i < SEGMENT_COUNT; i++)
     {
         // Load and track segment entity.
-        Entity segment = load_blueprint("boss_segment");
-        segments.push_back(segment);
-        vec3 * segment_position = &((Transform *)get_component(segment, "transform"))->position;
-        *segment_position = *position;
-        segment_destinations.push_back((vec2 *)get_component(segment, "destination"));
-        segment_positions.push_back(segment_position);
+        const Entity segment = load_blueprint("boss_segment");
+        boss_state.segments[i] = segment;
+        boss_state.segment_positions[i] = &component<Transform>(segment)->position;
+        *boss_state.segment_positions[i] = position;
 
-        segment_look_directions.push_back(
-            &((Orientation_Handler *)get_component(segment, "orientation_handler"))->look_direction);
+        boss_state.segment_look_directions[i] =
+            &component<Orientation_Handler>(segment)->look_direction;
 
-        game_manager_track_render_flag(boss_room, segment);
-        game_manager_track_collider_enabled_flag(boss_room, segment);
+        game_manager_track_render_flag(room, segment);
+        game_manager_track_collider_enabled_flag(room, segment);
 
 
         // Load and track segment connector entity.
-        Entity segment_connector = load_blueprint("boss_segment_connector");
-        segment_connectors.push_back(segment_connector);
-        segment_connector_transforms.push_back((Transform *)get_component(segment_connector, "transform"));
-        game_manager_track_render_flag(boss_room, segment_connector);
+        const Entity segment_connector = load_blueprint("boss_segment_connector");
+        boss_state.segment_connectors[i] = segment_connector;
+        boss_state.segment_connector_transforms[i] = component<Transform>(segment_connector);
+        game_manager_track_render_flag(room, segment_connector);
     }
 
-
-    update_segments();
+    boss_state.segment_count = SEGMENT_COUNT;
     return boss;
 }
 
@@ -1,89 +0,0 @@
-#include "Game/Systems/Boss_Segment.hpp"
-
-#include <map>
-#include <glm/glm.hpp>
-#include "Nito/Components.hpp"
-#include "Cpp_Utils/Map.hpp"
-#include "Cpp_Utils/Collection.hpp"
-
-#include "Game/Components.hpp"
-#include "Game/Utilities.hpp"
-
-
-using std::map;
-
-// glm/glm.hpp
-using glm::vec3;
-using glm::vec2;
-
-// Nito/APIs/ECS.hpp
-using Nito::Entity;
-using Nito::get_component;
-
-// Nito/Components.hpp
-using Nito::Transform;
-
-// Cpp_Utils/Map.hpp
-using Cpp_Utils::remove;
-
-// Cpp_Utils/Collection.hpp
-using Cpp_Utils::for_each;
-
-
-namespace Game
-{
-
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//
-// Data Structures
-//
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-struct Boss_Segment_State
-{
-    vec3 * position;
-    vec3 * look_direction;
-    vec2 * destination;
-};
-
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//
-// Data
-//
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-struct map<Entity, Boss_Segment_State> entity_states;
-
-
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//
-// Interface
-//
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void boss_segment_subscribe(Entity entity)
-{
-    entity_states[entity] =
-    {
-        &((Transform *)get_component(entity, "transform"))->position,
-        &((Orientation_Handler *)get_component(entity, "orientation_handler"))->look_direction,
-        (vec2 *)get_component(entity, "destination"),
-    };
-}
-
-
-void boss_segment_unsubscribe(Entity entity)
-{
-    remove(entity_states, entity);
-}
-
-
-void boss_segment_update()
-{
-    for_each(entity_states, [](Entity /*entity*/, Boss_Segment_State & entity_state) -> void
-    {
-        move_entity(*entity_state.position, *entity_state.look_direction, *entity_state.destination);
-    });
-}
-
-
-} // namespace Game
@@ -8,6 +8,7 @@
 #include "Cpp_Utils/Collection.hpp"
 #include "Cpp_Utils/Map.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/APIs/Floor_Manager.hpp"
 
 
@@ -22,7 +23,6 @@ using glm::vec2;
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
 using Nito::get_entity;
-using Nito::get_component;
 
 // Nito/Components.hpp
 using Nito::Transform;
@@ -65,12 +65,12 @@ static map<Entity, Entity_State> entity_states;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void camera_controller_subscribe(Entity entity)
 {
-    const auto target_id = (string *)get_component(entity, "target_id");
+    const auto target_id = component<Target_Id>(entity);
 
     entity_states[entity] =
     {
-        (Transform *)get_component(entity, "transform"),
-        (Transform *)get_component(get_entity(*target_id), "transform"),
+        component<Transform>(entity),
+        component<Transform>(get_entity(*target_id)),
     };
 }
 
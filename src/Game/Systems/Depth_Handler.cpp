@@ -1,27 +1,26 @@
 #include "Game/Systems/Depth_Handler.hpp"
 
 #include <map>
+#include <vector>
 #include <glm/glm.hpp>
 #include "Nito/Components.hpp"
-#include "Cpp_Utils/Collection.hpp"
 #include "Cpp_Utils/Map.hpp"
 
+#include "Game/Component_Types.hpp"
+
 
 using std::map;
+using std::vector;
 
 // glm/glm.hpp
 using glm::vec3;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 
 // Nito/Components.hpp
 using Nito::Transform;
 
-// Cpp_Utils/Collection.hpp
-using Cpp_Utils::for_each;
-
 // Cpp_Utils/Map.hpp
 using Cpp_Utils::remove;
 
@@ -30,12 +29,42 @@ namespace Game
 {
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Dirty depth states know their index in dirty_depth_states, so they can be removed from it in constant time; clean
+// ones have an index of -1.
+struct Depth_State
+{
+    vec3 * position;
+    int dirty_index;
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Data
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static map<Entity, vec3 *> entity_positions;
+static map<Entity, Depth_State> depth_states;
+static vector<Depth_State *> dirty_depth_states;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void set_dirty(Depth_State & depth_state)
+{
+    if (depth_state.dirty_index == -1)
+    {
+        depth_state.dirty_index = dirty_depth_states.size();
+        dirty_depth_states.push_back(&depth_state);
+    }
+}
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -45,22 +74,54 @@ static map<Entity, vec3 *> entity_positions;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void depth_handler_subscribe(Entity entity)
 {
-    entity_positions[entity] = &((Transform *)get_component(entity, "transform"))->position;
+    // Entities are usually positioned right after being loaded, so defer their initial depth to the next update.
+    Depth_State & depth_state = depth_states[entity];
+    depth_state.position = &component<Transform>(entity)->position;
+    depth_state.dirty_index = -1;
+    set_dirty(depth_state);
 }
 
 
 void depth_handler_unsubscribe(Entity entity)
 {
-    remove(entity_positions, entity);
+    Depth_State & depth_state = depth_states.at(entity);
+
+    // Move the last dirty depth state into the unsubscribed one's place.
+    if (depth_state.dirty_index != -1)
+    {
+        Depth_State * last_dirty_depth_state = dirty_depth_states.back();
+        last_dirty_depth_state->dirty_index = depth_state.dirty_index;
+        dirty_depth_states[depth_state.dirty_index] = last_dirty_depth_state;
+        dirty_depth_states.pop_back();
+    }
+
+    remove(depth_states, entity);
 }
 
 
 void depth_handler_update()
 {
-    for_each(entity_positions, [](Entity /*entity*/, vec3 * position) -> void
+    for (Depth_State * depth_state : dirty_depth_states)
     {
+        vec3 * position = depth_state->position;
         position->z = position->y;
-    });
+        depth_state->dirty_index = -1;
+    }
+
+    dirty_depth_states.clear();
+}
+
+
+void set_depth_dirty(Entity entity)
+{
+    // Entities moved before they're subscribed, like the player when the game manager places it on the first floor,
+    // already get their depth when they are.
+    const auto depth_state = depth_states.find(entity);
+
+    if (depth_state != depth_states.end())
+    {
+        set_dirty(depth_state->second);
+    }
 }
 
 
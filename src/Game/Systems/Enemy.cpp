@@ -1,12 +1,11 @@
 #include "Game/Systems/Enemy.hpp"
 
 #include "Game/Components.hpp"
-#include "Game/Systems/Item.hpp"
+#include "Game/Component_Types.hpp"
 
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 using Nito::flag_entity_for_deletion;
 
 
@@ -21,9 +20,8 @@ namespace Game
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void enemy_subscribe(Entity entity)
 {
-    ((Health *)get_component(entity, "health"))->death_handlers["enemy"] = [=]() -> void
+    component<Health>(entity)->death_handlers["enemy"] = [=]() -> void
     {
-        check_spawn_item(entity);
         flag_entity_for_deletion(entity);
     };
 }
@@ -1,6 +1,7 @@
 #include "Game/Systems/Game_Manager.hpp"
 
 #include <map>
+#include <vector>
 #include <stdexcept>
 #include <glm/glm.hpp>
 #include "Nito/Components.hpp"
@@ -9,15 +10,20 @@
 #include "Cpp_Utils/Map.hpp"
 #include "Cpp_Utils/Collection.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/APIs/Floor_Manager.hpp"
 #include "Game/APIs/Enemy_Manager.hpp"
 #include "Game/APIs/Minimap.hpp"
+#include "Game/APIs/Floor_Snapshot.hpp"
 #include "Game/Systems/Floor_Entity.hpp"
+#include "Game/Systems/Light_Handler.hpp"
+#include "Game/Systems/Depth_Handler.hpp"
 
 
 using std::string;
 using std::function;
 using std::map;
+using std::vector;
 using std::runtime_error;
 
 // glm/glm.hpp
@@ -26,13 +32,11 @@ using glm::vec2;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 using Nito::get_entity;
 
 // Nito/Components.hpp
 using Nito::Transform;
 using Nito::Sprite;
-using Nito::Light_Source;
 
 // Nito/Collider_Component.hpp
 using Nito::Collider;
@@ -65,6 +69,7 @@ using Room_Flags = map<int, map<Entity, bool *>>;
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static map<string, function<void(int, int)>> room_change_handlers;
+static Entity player;
 static vec3 * player_position;
 static const vec2 * spawn_position;
 static int last_room;
@@ -90,15 +95,43 @@ static void set_room_flags(Room_Flags & room_flags, int room, bool value)
 }
 
 
-static void start_floor()
+static void set_room_enabled(int room, bool enabled)
+{
+    set_room_flags(render_flags, room, enabled);
+    set_room_flags(collider_enabled_flags, room, enabled);
+    set_room_flags(enemy_enabled_flags, room, enabled);
+    set_room_flags(light_source_enabled_flags, room, enabled);
+}
+
+
+// Releases built rooms that are no longer door-adjacent to the current room, then builds the ones that now are, so
+// released tiles are reused by the rooms being built.
+static void stream_rooms()
+{
+    vector<int> released_rooms;
+    vector<int> unbuilt_rooms;
+    get_room_stream_changes(current_room, get_built_rooms(), released_rooms, unbuilt_rooms);
+
+    for (const int room : released_rooms)
+    {
+        release_room_enemies(room);
+        release_room(room);
+    }
+
+    for (const int room : unbuilt_rooms)
+    {
+        build_room(room);
+        spawn_room_enemies(room);
+        set_room_enabled(room, false);
+    }
+}
+
+
+static void initialize_floor()
 {
-    last_room = spawn_room_id;
-    current_room = spawn_room_id;
-    generate_floor(5);
-    generate_minimap();
-    generate_enemies();
     player_position->x = spawn_position->x;
     player_position->y = spawn_position->y;
+    set_depth_dirty(player);
 
 
     // Initialize flags.
@@ -122,10 +155,18 @@ static void start_floor()
         set_room_flags(light_source_enabled_flags, room, false);
     });
 
-    set_room_flags(render_flags, spawn_room_id, true);
-    set_room_flags(collider_enabled_flags, spawn_room_id, true);
-    set_room_flags(enemy_enabled_flags, spawn_room_id, true);
-    set_room_flags(light_source_enabled_flags, spawn_room_id, true);
+    set_room_enabled(spawn_room_id, true);
+}
+
+
+static void start_floor()
+{
+    last_room = spawn_room_id;
+    current_room = spawn_room_id;
+    generate_floor(5);
+    generate_minimap();
+    generate_enemies();
+    initialize_floor();
 }
 
 
@@ -148,7 +189,8 @@ static void cleanup_floor()
 void game_manager_subscribe(Entity /*entity*/)
 {
     spawn_room_id = get_spawn_room_id();
-    player_position = &((Transform *)get_component(get_entity("player"), "transform"))->position;
+    player = get_entity("player");
+    player_position = &component<Transform>(player)->position;
     spawn_position = &get_spawn_position();
     minimap_api_init();
     floor_manager_api_init();
@@ -192,8 +234,15 @@ void game_manager_change_rooms(float door_rotation)
         throw runtime_error("ERROR: invalid door rotation: " + to_string(door_rotation) + "!");
     }
 
+    set_depth_dirty(player);
+
     current_room = get_room(*player_position);
 
+    if (is_floor_streaming())
+    {
+        stream_rooms();
+    }
+
 
     // Trigger room-change handlers.
     for_each(room_change_handlers, [=](
@@ -205,14 +254,8 @@ void game_manager_change_rooms(float door_rotation)
 
 
     // Update room flags.
-    set_room_flags(render_flags, last_room, false);
-    set_room_flags(render_flags, current_room, true);
-    set_room_flags(collider_enabled_flags, last_room, false);
-    set_room_flags(collider_enabled_flags, current_room, true);
-    set_room_flags(enemy_enabled_flags, last_room, false);
-    set_room_flags(enemy_enabled_flags, current_room, true);
-    set_room_flags(light_source_enabled_flags, last_room, false);
-    set_room_flags(light_source_enabled_flags, current_room, true);
+    set_room_enabled(last_room, false);
+    set_room_enabled(current_room, true);
 }
 
 
@@ -236,9 +279,27 @@ void game_manager_complete_floor()
 }
 
 
+void game_manager_save_floor(const string & path)
+{
+    save_floor_snapshot(path);
+}
+
+
+void game_manager_load_floor(const string & path)
+{
+    floor_entity_destroy_all();
+    cleanup_floor();
+    last_room = spawn_room_id;
+    current_room = spawn_room_id;
+    load_floor_snapshot(path);
+    generate_minimap();
+    initialize_floor();
+}
+
+
 void game_manager_track_render_flag(int room, Entity entity)
 {
-    render_flags[room][entity] = &((Sprite *)get_component(entity, "sprite"))->render;
+    render_flags[room][entity] = &component<Sprite>(entity)->render;
 }
 
 
@@ -250,7 +311,7 @@ void game_manager_untrack_render_flag(int room, Entity entity)
 
 void game_manager_track_collider_enabled_flag(int room, Entity entity)
 {
-    collider_enabled_flags[room][entity] = &((Collider *)get_component(entity, "collider"))->enabled;
+    collider_enabled_flags[room][entity] = &component<Collider>(entity)->enabled;
 }
 
 
@@ -262,7 +323,7 @@ void game_manager_untrack_collider_enabled_flag(int room, Entity entity)
 
 void game_manager_track_enemy_enabled_flag(int room, Entity entity)
 {
-    enemy_enabled_flags[room][entity] = (bool *)get_component(entity, "enemy_enabled");
+    enemy_enabled_flags[room][entity] = component<Enemy_Enabled>(entity);
 }
 
 
@@ -274,7 +335,7 @@ void game_manager_untrack_enemy_enabled_flag(int room, Entity entity)
 
 void game_manager_track_light_source_enabled_flag(int room, Entity entity)
 {
-    light_source_enabled_flags[room][entity] = &((Light_Source *)get_component(entity, "light_source"))->enabled;
+    light_source_enabled_flags[room][entity] = get_light_room_enabled_flag(entity);
 }
 
 
@@ -284,4 +345,10 @@ void game_manager_untrack_light_source_enabled_flag(int room, Entity entity)
 }
 
 
+void game_manager_refresh_room_flags(int room)
+{
+    set_room_enabled(room, room == current_room);
+}
+
+
 } // namespace Game
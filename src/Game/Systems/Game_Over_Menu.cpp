@@ -7,6 +7,7 @@
 #include "Nito/APIs/Scene.hpp"
 #include "Nito/APIs/Input.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Components.hpp"
 #include "Game/Systems/Menu_Controller.hpp"
 
@@ -18,7 +19,6 @@ using std::runtime_error;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 
 // Nito/APIs/Scene.hpp
 using Nito::set_scene_to_load;
@@ -76,7 +76,7 @@ void game_over_menu_subscribe(Entity _entity)
         throw runtime_error("ERROR: only one entity is allowed to subscribed to the game_over_menu system per scene!");
     }
 
-    entity_menu_buttons_handler = (Menu_Buttons_Handler *)get_component(entity, "menu_buttons_handler");
+    entity_menu_buttons_handler = component<Menu_Buttons_Handler>(entity);
     map<string, function<void()>> & button_handlers = entity_menu_buttons_handler->button_handlers;
 
     button_handlers["RESTART"] = []() -> void
@@ -6,6 +6,7 @@
 #include "Cpp_Utils/Map.hpp"
 #include "Cpp_Utils/Collection.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Components.hpp"
 
 
@@ -15,7 +16,6 @@ using std::function;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 
 // Cpp_Utils/Map.hpp
 using Cpp_Utils::remove;
@@ -43,7 +43,7 @@ static map<Entity, Health *> entity_healths;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void health_subscribe(Entity entity)
 {
-    entity_healths[entity] = (Health *)get_component(entity, "health");
+    entity_healths[entity] = component<Health>(entity);
 }
 
 
@@ -6,6 +6,7 @@
 #include "Cpp_Utils/Map.hpp"
 #include "Cpp_Utils/Collection.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Components.hpp"
 
 
@@ -14,7 +15,6 @@ using std::string;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 using Nito::get_entity;
 using Nito::flag_entity_for_deletion;
 
@@ -60,8 +60,8 @@ static map<Entity, Health_Bar_State> entity_states;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void health_bar_subscribe(Entity entity)
 {
-    float * health_bar_width = &((Dimensions *)get_component(entity, "dimensions"))->width;
-    auto target_health = (Health *)get_component(get_entity(*(string *)get_component(entity, "target_id")), "health");
+    float * health_bar_width = &component<Dimensions>(entity)->width;
+    auto target_health = component<Health>(get_entity(*component<Target_Id>(entity)));
 
     target_health->death_handlers["health_bar"] = [=]() -> void
     {
@@ -1,12 +1,12 @@
 #include "Game/Systems/Health_Item.hpp"
 
 #include "Game/Components.hpp"
+#include "Game/Component_Types.hpp"
 #include "Game/Systems/Health.hpp"
 
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 
 
 namespace Game
@@ -20,11 +20,11 @@ namespace Game
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void health_item_subscribe(Entity entity)
 {
-    const auto health_item = (Health_Item *)get_component(entity, "health_item");
+    const auto health_item = component<Health_Item>(entity);
 
-    ((Item *)get_component(entity, "item"))->pick_up_handler = [=](Entity player) -> bool
+    component<Item>(entity)->pick_up_handler = [=](Entity player) -> bool
     {
-        auto player_health = (Health *)get_component(player, "health");
+        auto player_health = component<Health>(player);
 
         if (player_health->current < player_health->max)
         {
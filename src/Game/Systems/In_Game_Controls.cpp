@@ -4,6 +4,7 @@
 #include "Nito/Engine.hpp"
 #include "Nito/APIs/Input.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Components.hpp"
 #include "Game/Systems/Pause_Menu.hpp"
 #include "Game/Systems/Game_Over_Menu.hpp"
@@ -13,7 +14,6 @@ using std::string;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 using Nito::get_entity;
 
 // Nito/APIs/Input.hpp
@@ -85,7 +85,7 @@ void in_game_controls_subscribe(Entity /*entity*/)
     entity_game_over = false;
     set_key_handler(PAUSE_HANDLER_ID, Keys::ESCAPE, Button_Actions::PRESS, toggle_paused);
     set_controller_button_handler(PAUSE_HANDLER_ID, DS4_Buttons::START, Button_Actions::PRESS, toggle_paused);
-    auto player_health = (Health *)get_component(get_entity("player"), "health");
+    auto player_health = component<Health>(get_entity("player"));
     player_health->death_handlers["in_game_controls player death"] = game_over;
 }
 
@@ -3,36 +3,39 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <functional>
+#include <stdexcept>
 #include <glm/glm.hpp>
 #include "Nito/Components.hpp"
 #include "Nito/Collider_Component.hpp"
 #include "Nito/APIs/Scene.hpp"
-#include "Cpp_Utils/Vector.hpp"
 #include "Cpp_Utils/Map.hpp"
-#include "Cpp_Utils/JSON.hpp"
 #include "Cpp_Utils/Collection.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Utilities.hpp"
 #include "Game/Components.hpp"
 #include "Game/APIs/Floor_Manager.hpp"
+#include "Game/APIs/Drop_Table.hpp"
 #include "Game/Systems/Game_Manager.hpp"
 
 
 using std::vector;
 using std::string;
 using std::map;
+using std::function;
+using std::runtime_error;
 
 // glm/glm.hpp
 using glm::vec3;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
-using Nito::has_component;
 using Nito::flag_entity_for_deletion;
 
 // Nito/Components.hpp
 using Nito::Transform;
+using Nito::Light_Source;
 
 // Nito/Collider_Component.hpp
 using Nito::Collider;
@@ -40,16 +43,9 @@ using Nito::Collider;
 // Nito/APIs/Scene.hpp
 using Nito::load_blueprint;
 
-// Cpp_Utils/Vector.hpp
-using Cpp_Utils::contains;
-
 // Cpp_Utils/Map.hpp
 using Cpp_Utils::remove;
 
-// Cpp_Utils/JSON.hpp
-using Cpp_Utils::read_json_file;
-using Cpp_Utils::JSON;
-
 // Cpp_Utils/Collection.hpp
 using Cpp_Utils::for_each;
 
@@ -60,62 +56,48 @@ namespace Game
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
-// Data
+// Data Structures
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-static map<Entity, int> item_rooms;
-static vector<string> item_names;
-static vector<const string *> item_spawn_index;
+struct Item_State
+{
+    int room;
+    const string * name;
+    const vec3 * position;
+};
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
-// Interface
+// Data
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void item_init()
-{
-    const map<string, int> item_spawn_ratios =
-        read_json_file("resources/data/item_spawn_ratios.json").get<map<string, int>>();
-
-    for_each(item_spawn_ratios, [](const string & item_name, int /*spawn_ratio*/) -> void
-    {
-        item_names.push_back(item_name);
-    });
-
-    for (const string & item_name : item_names)
-    {
-        const int spawn_ratio = item_spawn_ratios.at(item_name);
-        const string * item_name_ptr = &item_name;
-
-        for (int i = 0; i < spawn_ratio; i++)
-        {
-            item_spawn_index.push_back(item_name_ptr);
-        }
-    }
-}
+static map<Entity, Item_State> item_states;
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void item_subscribe(Entity entity)
 {
     static const string PLAYER_LAYER("player");
-    static const string LAYERS_COMPONENT("layers");
 
-    const auto item = (Item *)get_component(entity, "item");
+    const auto item = component<Item>(entity);
 
-    ((Collider *)get_component(entity, "collider"))->collision_handler = [=](Entity collision_entity) -> void
+    component<Collider>(entity)->collision_handler = [=](Entity collision_entity) -> void
     {
-        if (has_component(collision_entity, LAYERS_COMPONENT) &&
-            contains(*(vector<string> *)get_component(collision_entity, LAYERS_COMPONENT), PLAYER_LAYER))
+        if (in_layer(collision_entity, PLAYER_LAYER))
         {
             if (item->pick_up_handler(collision_entity))
             {
-                const int room = item_rooms.at(entity);
+                const int room = item_states.at(entity).room;
                 flag_entity_for_deletion(entity);
                 game_manager_untrack_render_flag(room, entity);
                 game_manager_untrack_collider_enabled_flag(room, entity);
 
-                if (has_component(entity, "light_source"))
+                if (has<Light_Source>(entity))
                 {
                     game_manager_untrack_light_source_enabled_flag(room, entity);
                 }
@@ -127,33 +109,56 @@ void item_subscribe(Entity entity)
 
 void item_unsubscribe(Entity entity)
 {
-    remove(item_rooms, entity);
+    remove(item_states, entity);
+    release_floor_tile(entity);
 }
 
 
-void check_spawn_item(Entity enemy)
+void check_spawn_item(Enemies enemy, int room, const vec3 & position)
 {
-    if (random(0, 5) == 0)
+    const string * item_name = sample_item_drop(enemy);
+
+    if (item_name != nullptr)
     {
-        // Spawn random item.
-        const Entity item = load_blueprint(*item_spawn_index[random(0, item_spawn_index.size())]);
+        spawn_item(*item_name, room, position);
+    }
+}
 
-        ((Transform *)get_component(item, "transform"))->position =
-            ((Transform *)get_component(enemy, "transform"))->position;
 
+void spawn_item(const string & name, int room, const vec3 & position)
+{
+    const string * item_name = get_droppable_item_name(name);
 
-        // Track item in game manager.
-        const int room = get_enemy_room(enemy);
-        item_rooms[item] = room;
-        game_manager_track_render_flag(room, item);
-        game_manager_track_collider_enabled_flag(room, item);
+    if (item_name == nullptr)
+    {
+        throw runtime_error("ERROR: \"" + name + "\" is not a spawnable item!");
+    }
 
-        if (has_component(item, "light_source"))
-        {
-            game_manager_track_light_source_enabled_flag(room, item);
-        }
+    const Entity item = load_blueprint(name);
+    vec3 & item_position = component<Transform>(item)->position;
+    item_position = position;
+    item_states[item] = { room, item_name, &item_position };
+    occupy_floor_tile(item, get_room_tile_coordinates(position));
+
+
+    // Track item in game manager.
+    game_manager_track_render_flag(room, item);
+    game_manager_track_collider_enabled_flag(room, item);
+
+    if (has<Light_Source>(item))
+    {
+        game_manager_track_light_source_enabled_flag(room, item);
     }
 }
 
 
+void iterate_items(const function<void(const string &, int, const vec3 &)> & callback)
+{
+    for_each(item_states, [&](Entity /*item*/, const Item_State & item_state) -> void
+    {
+        callback(*item_state.name, item_state.room, *item_state.position);
+    });
+}
+
+
 } // namespace Game
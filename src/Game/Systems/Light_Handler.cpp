@@ -0,0 +1,281 @@
+#include "Game/Systems/Light_Handler.hpp"
+
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <glm/glm.hpp>
+#include "Nito/Components.hpp"
+#include "Nito/APIs/Window.hpp"
+#include "Nito/APIs/Graphics.hpp"
+#include "Cpp_Utils/Map.hpp"
+
+#include "Game/Component_Types.hpp"
+
+
+using std::map;
+using std::vector;
+using std::sort;
+using std::partition;
+using std::nth_element;
+using std::runtime_error;
+
+// glm/glm.hpp
+using glm::vec3;
+using glm::vec2;
+using glm::ivec2;
+using glm::abs;
+using glm::floor;
+using glm::dot;
+using glm::min;
+
+// Nito/APIs/ECS.hpp
+using Nito::Entity;
+using Nito::get_entity;
+
+// Nito/Components.hpp
+using Nito::Transform;
+using Nito::Light_Source;
+
+// Nito/APIs/Window.hpp
+using Nito::get_window_size;
+
+// Nito/APIs/Graphics.hpp
+using Nito::get_pixels_per_unit;
+
+// Cpp_Utils/Map.hpp
+using Cpp_Utils::contains_key;
+using Cpp_Utils::remove;
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct Light_State
+{
+    Entity entity;
+    Light_Source * light_source;
+    const vec3 * position;
+    const bool * room_enabled;
+    float base_intensity;
+    float range;
+    bool mergeable;
+};
+
+
+struct Active_Light
+{
+    Light_State * light_state;
+    float intensity;
+    float importance;
+    ivec2 merge_cell;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const int MAX_ACTIVE_LIGHTS = 32;
+static const float MERGE_CELL_SIZE = 0.5f;
+static const float MAX_MERGED_INTENSITY_SCALE = 3.0f;
+static vector<Light_State> light_states;
+static map<Entity, int> light_state_indexes;
+static map<Entity, bool> light_room_enabled_flags;
+static vector<Active_Light> active_lights;
+static const vec3 * player_position;
+static const Transform * camera_transform;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void cull_lights()
+{
+    const vec3 & camera_position = camera_transform->position;
+
+    const vec2 view_half_extents =
+        (vec2)get_window_size() / (2.0f * get_pixels_per_unit()) / (vec2)camera_transform->scale;
+
+    active_lights.clear();
+
+    for (Light_State & light_state : light_states)
+    {
+        light_state.light_source->enabled = false;
+
+        if (!*light_state.room_enabled)
+        {
+            continue;
+        }
+
+        const vec2 position = (vec2)*light_state.position;
+        const vec2 camera_offset = abs(position - (vec2)camera_position);
+        const float range = light_state.range;
+
+        if (camera_offset.x > view_half_extents.x + range || camera_offset.y > view_half_extents.y + range)
+        {
+            continue;
+        }
+
+        active_lights.push_back(
+            {
+                &light_state,
+                light_state.base_intensity,
+                0.0f,
+                light_state.mergeable ? (ivec2)floor(position / MERGE_CELL_SIZE) : ivec2(0),
+            });
+    }
+}
+
+
+static void merge_lights()
+{
+    // Move mergeable lights to the end of the active lights and sort them by cell so lights sharing a cell are
+    // adjacent.
+    const auto mergeable_lights_begin =
+        partition(active_lights.begin(), active_lights.end(), [](const Active_Light & active_light) -> bool
+        {
+            return !active_light.light_state->mergeable;
+        });
+
+    sort(mergeable_lights_begin, active_lights.end(), [](const Active_Light & a, const Active_Light & b) -> bool
+    {
+        return a.merge_cell.x != b.merge_cell.x ? a.merge_cell.x < b.merge_cell.x : a.merge_cell.y < b.merge_cell.y;
+    });
+
+
+    // Fold each run of lights sharing a cell into its first light, capping the merged intensity so dense clusters
+    // don't blow out.
+    auto merged_light = mergeable_lights_begin;
+
+    for (auto active_light = mergeable_lights_begin; active_light != active_lights.end(); active_light++)
+    {
+        if (active_light != mergeable_lights_begin && active_light->merge_cell == (merged_light - 1)->merge_cell)
+        {
+            Active_Light & cell_light = *(merged_light - 1);
+
+            cell_light.intensity = min(
+                cell_light.intensity + active_light->intensity,
+                cell_light.light_state->base_intensity * MAX_MERGED_INTENSITY_SCALE);
+        }
+        else
+        {
+            *merged_light++ = *active_light;
+        }
+    }
+
+    active_lights.erase(merged_light, active_lights.end());
+}
+
+
+static void budget_lights()
+{
+    for (Active_Light & active_light : active_lights)
+    {
+        const vec2 player_offset = (vec2)*active_light.light_state->position - (vec2)*player_position;
+        active_light.importance = active_light.intensity / (1.0f + dot(player_offset, player_offset));
+    }
+
+    if ((int)active_lights.size() <= MAX_ACTIVE_LIGHTS)
+    {
+        return;
+    }
+
+    nth_element(
+        active_lights.begin(),
+        active_lights.begin() + MAX_ACTIVE_LIGHTS,
+        active_lights.end(),
+        [](const Active_Light & a, const Active_Light & b) -> bool
+        {
+            return a.importance > b.importance;
+        });
+
+    active_lights.resize(MAX_ACTIVE_LIGHTS);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void light_handler_subscribe(Entity entity)
+{
+    if (light_states.empty())
+    {
+        player_position = &component<Transform>(get_entity("player"))->position;
+        camera_transform = component<Transform>(get_entity("camera"));
+    }
+
+    auto light_source = component<Light_Source>(entity);
+    bool & room_enabled = light_room_enabled_flags[entity];
+    room_enabled = light_source->enabled;
+    light_state_indexes[entity] = light_states.size();
+
+    light_states.push_back(
+        {
+            entity,
+            light_source,
+            &component<Transform>(entity)->position,
+            &room_enabled,
+            light_source->intensity,
+            light_source->range,
+            has<Projectile>(entity),
+        });
+}
+
+
+void light_handler_unsubscribe(Entity entity)
+{
+    // Swap the last light into the removed light's slot to keep the light states compact.
+    const int index = light_state_indexes.at(entity);
+    const Light_State & last_light_state = light_states.back();
+    light_state_indexes[last_light_state.entity] = index;
+    light_states[index] = last_light_state;
+    light_states.pop_back();
+    remove(light_state_indexes, entity);
+    remove(light_room_enabled_flags, entity);
+}
+
+
+void light_handler_update()
+{
+    if (light_states.empty())
+    {
+        return;
+    }
+
+    cull_lights();
+    merge_lights();
+    budget_lights();
+
+    for (const Active_Light & active_light : active_lights)
+    {
+        Light_Source * light_source = active_light.light_state->light_source;
+        light_source->enabled = true;
+        light_source->intensity = active_light.intensity;
+    }
+}
+
+
+bool * get_light_room_enabled_flag(Entity entity)
+{
+    if (!contains_key(light_room_enabled_flags, entity))
+    {
+        throw runtime_error("ERROR: entity is not subscribed to the light_handler system!");
+    }
+
+    return &light_room_enabled_flags[entity];
+}
+
+
+} // namespace Game
@@ -8,6 +8,7 @@
 #include "Nito/APIs/Scene.hpp"
 #include "Nito/APIs/Input.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Components.hpp"
 
 
@@ -18,7 +19,6 @@ using std::runtime_error;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 
 // Nito/APIs/Window.hpp
 using Nito::close_window;
@@ -63,7 +63,7 @@ void main_menu_subscribe(Entity entity)
         throw runtime_error("ERROR: only one entity is allowed to be subscribed to the main_menu system per scene!");
     }
 
-    entity_menu_buttons_handler = (Menu_Buttons_Handler *)get_component(entity, "menu_buttons_handler");
+    entity_menu_buttons_handler = component<Menu_Buttons_Handler>(entity);
     map<string, function<void()>> & button_handlers = entity_menu_buttons_handler->button_handlers;
 
     button_handlers["PLAY"] = []() -> void
@@ -71,6 +71,11 @@ void main_menu_subscribe(Entity entity)
         set_scene_to_load("game");
     };
 
+    button_handlers["BENCHMARK"] = []() -> void
+    {
+        set_scene_to_load("stress_benchmark");
+    };
+
     button_handlers["EXIT"] = close_window;
     set_key_handler(EXIT_HANDLER_ID, Keys::ESCAPE, Button_Actions::PRESS, close_window);
     set_controller_button_handler(EXIT_HANDLER_ID, DS4_Buttons::CIRCLE, Button_Actions::PRESS, close_window);
@@ -83,6 +88,7 @@ void main_menu_unsubscribe(Entity /*entity*/)
 
     map<string, function<void()>> & button_handlers = entity_menu_buttons_handler->button_handlers;
     button_handlers["PLAY"] = DUD;
+    button_handlers["BENCHMARK"] = DUD;
     button_handlers["EXIT"] = DUD;
     entity_menu_buttons_handler = nullptr;
     remove_key_handler(EXIT_HANDLER_ID);
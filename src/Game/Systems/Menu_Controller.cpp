@@ -7,6 +7,7 @@
 #include "Cpp_Utils/Map.hpp"
 #include "Cpp_Utils/String.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Systems/Menu_Buttons_Handler.hpp"
 
 
@@ -18,7 +19,6 @@ using glm::vec3;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 
 // Nito/Components.hpp
 using Nito::Transform;
@@ -50,7 +50,7 @@ static map<Entity, Transform *> entity_transforms;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void menu_controller_subscribe(Entity entity)
 {
-    entity_transforms[entity] = (Transform *)get_component(entity, "transform");
+    entity_transforms[entity] = component<Transform>(entity);
 }
 
 
@@ -8,6 +8,7 @@
 #include "Cpp_Utils/Map.hpp"
 #include "Cpp_Utils/Collection.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Components.hpp"
 
 
@@ -19,7 +20,6 @@ using glm::vec3;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 
 // Nito/Components.hpp
 using Nito::Sprite;
@@ -82,8 +82,8 @@ void orientation_handler_subscribe(Entity entity)
 {
     entity_states[entity] =
     {
-        (Sprite *)get_component(entity, "sprite"),
-        (Orientation_Handler *)get_component(entity, "orientation_handler"),
+        component<Sprite>(entity),
+        component<Orientation_Handler>(entity),
     };
 }
 
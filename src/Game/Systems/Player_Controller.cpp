@@ -14,9 +14,16 @@
 #include "Nito/APIs/Input.hpp"
 #include "Nito/APIs/Window.hpp"
 #include "Nito/APIs/Graphics.hpp"
+#include "Cpp_Utils/Vector.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Components.hpp"
 #include "Game/Utilities.hpp"
+#include "Game/Systems/Depth_Handler.hpp"
+#include "Game/Systems/Projectile.hpp"
+#include "Game/APIs/Floor_Manager.hpp"
+#include "Game/APIs/Frame_Arena.hpp"
+#include "Game/APIs/Bullet_Patterns.hpp"
 
 
 using std::map;
@@ -27,13 +34,13 @@ using std::runtime_error;
 // glm/glm.hpp
 using glm::vec3;
 using glm::vec2;
+using glm::ivec2;
 
 // glm/gtc/matrix_transform.hpp
 using glm::normalize;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 using Nito::get_entity;
 
 // Nito/Engine.hpp
@@ -64,18 +71,41 @@ using Nito::get_window_size;
 // Nito/Graphics.hpp
 using Nito::get_pixels_per_unit;
 
+// Cpp_Utils/Vector.hpp
+using Cpp_Utils::contains;
+
 
 namespace Game
 {
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// What the autoplay bot is doing in its current room: the room tiles it's walking along and how often it has entered
+// each room on this floor, so it explores rooms it hasn't been to before backtracking.
+struct Bot_State
+{
+    int room;
+    int room_enemy_count;
+    float plan_time;
+    vector<ivec2> path;
+    int path_index;
+    map<int, int> room_visits;
+};
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Data
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static const string FIRE_HANDLER_ID = "player_controller fire";
-static const vector<string> TARGET_LAYERS { "enemy" };
+static const string BOT_FLOOR_GENERATED_HANDLER_ID = "player_controller bot";
+static const string BULLET_PATTERN = "player_orb";
+static Entity player;
 static Transform * transform;
 static Dimensions * dimensions;
 static Orientation_Handler * orientation_handler;
@@ -85,6 +115,8 @@ static vec3 * camera_origin;
 static int pixels_per_unit;
 static float time_scale;
 static vec2 mouse_world_position;
+static Bot_State bot_state;
+static Bullet_Emitter bullet_emitter;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -101,7 +133,6 @@ static bool is_paused()
 static void fire()
 {
     static const float VERTICAL_Y_OFFSET = 0.05f;
-    static const string PROJECTILE_NAME("projectile_blue_orb");
 
 
     // Don't fire if the game is paused.
@@ -143,7 +174,7 @@ static void fire()
     vec3 fire_direction;
     const vec2 position_2d = (vec2)transform->position;
 
-    if (player_controller->mode == Player_Controller::Modes::CONTROLLER ||
+    if (player_controller->mode != Player_Controller::Modes::KEYBOARD_MOUSE ||
         distance(mouse_world_position, position_2d) < distance((vec2)projectile_origin, position_2d))
     {
         fire_direction = orientation_handler->look_direction;
@@ -153,12 +184,308 @@ static void fire()
         fire_direction = vec3(mouse_world_position.x, mouse_world_position.y, 0) - projectile_origin;
     }
 
-    fire_projectile(
-        PROJECTILE_NAME,
-        projectile_origin,
-        fire_direction,
-        1.0f,
-        TARGET_LAYERS);
+    emit_bullet_pattern(BULLET_PATTERN, bullet_emitter, projectile_origin, fire_direction);
+}
+
+
+static void reset_bot()
+{
+    bot_state.room = -1;
+    bot_state.room_enemy_count = 0;
+    bot_state.path.clear();
+    bot_state.path_index = 0;
+    bot_state.room_visits.clear();
+}
+
+
+// Finds a room tile of the given type in a room, scanning each floor section the room covers.
+static bool find_bot_room_tile(int room, Tile_Types tile_type, ivec2 & coordinates)
+{
+    const int floor_size = get_floor_size();
+    const int room_tile_width = get_room_tile_width();
+    const int room_tile_height = get_room_tile_height();
+
+    for (int room_x = 0; room_x < floor_size; room_x++)
+    {
+        for (int room_y = 0; room_y < floor_size; room_y++)
+        {
+            if (get_room(room_x, room_y) != room)
+            {
+                continue;
+            }
+
+            for (int x = room_x * room_tile_width; x < (room_x + 1) * room_tile_width; x++)
+            {
+                for (int y = room_y * room_tile_height; y < (room_y + 1) * room_tile_height; y++)
+                {
+                    if (get_room_tile(x, y).type == tile_type)
+                    {
+                        coordinates = ivec2(x, y);
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+
+// Breadth-first search over the walkable tiles of a room. The target itself doesn't need to be walkable, so doors and
+// enemies standing on tiles can be walked up to.
+static vector<ivec2> find_bot_path(int room, const ivec2 & start, const ivec2 & target)
+{
+    static const ivec2 NEIGHBOR_OFFSETS[] { { 0, -1 }, { -1, 0 }, { 0, 1 }, { 1, 0 } };
+
+    const int floor_tile_width = get_floor_size() * get_room_tile_width();
+    const int floor_tile_height = get_floor_size() * get_room_tile_height();
+    const Frame_Arena_Scope frame_arena_scope;
+    Frame_Vector<int> previous_tiles(floor_tile_width * floor_tile_height, -1);
+    Frame_Vector<ivec2> open_tiles { start };
+    vector<ivec2> path;
+
+    const auto get_tile_index = [=](const ivec2 & coordinates) -> int
+    {
+        return (coordinates.y * floor_tile_width) + coordinates.x;
+    };
+
+    if (start.x < 0 || start.x >= floor_tile_width ||
+        start.y < 0 || start.y >= floor_tile_height)
+    {
+        return path;
+    }
+
+    previous_tiles[get_tile_index(start)] = get_tile_index(start);
+
+    for (int open_index = 0; open_index < (int)open_tiles.size(); open_index++)
+    {
+        const ivec2 coordinates = open_tiles[open_index];
+
+        if (coordinates == target)
+        {
+            for (ivec2 path_tile = target; path_tile != start; )
+            {
+                const int previous_tile = previous_tiles[get_tile_index(path_tile)];
+                path.insert(path.begin(), path_tile);
+                path_tile = ivec2(previous_tile % floor_tile_width, previous_tile / floor_tile_width);
+            }
+
+            return path;
+        }
+
+        for (const ivec2 & neighbor_offset : NEIGHBOR_OFFSETS)
+        {
+            const ivec2 neighbor = coordinates + neighbor_offset;
+
+            if (neighbor.x < 0 || neighbor.x >= floor_tile_width ||
+                neighbor.y < 0 || neighbor.y >= floor_tile_height ||
+                previous_tiles[get_tile_index(neighbor)] != -1)
+            {
+                continue;
+            }
+
+            const Tile tile = get_room_tile(neighbor.x, neighbor.y);
+
+            if (neighbor != target && (tile.room != room || !is_walkable(tile.type)))
+            {
+                continue;
+            }
+
+            previous_tiles[get_tile_index(neighbor)] = get_tile_index(coordinates);
+            open_tiles.push_back(neighbor);
+        }
+    }
+
+    return path;
+}
+
+
+static const Transform * get_nearest_enemy(int room, const vec2 & position)
+{
+    const Transform * nearest_enemy = nullptr;
+    float nearest_distance = 0.0f;
+
+    for (const Entity enemy : get_room_enemies(room))
+    {
+        const Transform * enemy_transform = component<Transform>(enemy);
+        const float enemy_distance = distance(position, (vec2)enemy_transform->position);
+
+        if (nearest_enemy == nullptr || enemy_distance < nearest_distance)
+        {
+            nearest_enemy = enemy_transform;
+            nearest_distance = enemy_distance;
+        }
+    }
+
+    return nearest_enemy;
+}
+
+
+// While enemies are left the bot walks toward the nearest one, then once the room is clear it heads for the next floor
+// if the room has one, or else through the door to the least visited neighboring room, preferring deeper rooms as they
+// lead toward the boss.
+static void plan_bot_path(int room, const vec2 & position)
+{
+    const Transform * nearest_enemy = get_nearest_enemy(room, position);
+    ivec2 target;
+
+    bot_state.path.clear();
+    bot_state.path_index = 0;
+    bot_state.plan_time = get_time();
+
+    if (nearest_enemy != nullptr)
+    {
+        target = get_room_tile_coordinates((vec2)nearest_enemy->position);
+    }
+    else if (!find_bot_room_tile(room, Tile_Types::NEXT_FLOOR, target))
+    {
+        const Room_Door * target_door = nullptr;
+
+        for (const Room_Door & door : get_room_doors(room))
+        {
+            const int door_visits = bot_state.room_visits[door.room];
+
+            if (target_door == nullptr ||
+                door_visits < bot_state.room_visits[target_door->room] ||
+                (door_visits == bot_state.room_visits[target_door->room] &&
+                 get_room_depth(door.room) > get_room_depth(target_door->room)))
+            {
+                target_door = &door;
+            }
+        }
+
+        if (target_door == nullptr)
+        {
+            return;
+        }
+
+        target = target_door->coordinates;
+    }
+
+    bot_state.path = find_bot_path(room, get_room_tile_coordinates(position), target);
+}
+
+
+// Steers out of the path of hostile projectiles heading toward the player, weighting closer projectiles more heavily.
+static vec2 get_bot_dodge_direction(const vec2 & position)
+{
+    static const float DODGE_DISTANCE = 3.0f;
+    static const float DODGE_WIDTH = 0.5f;
+    static const string PLAYER_LAYER("player");
+
+    vec2 dodge_direction(0.0f);
+
+    projectile_iterate([&](const Transform & projectile_transform, const Projectile & projectile) -> void
+    {
+        if (!contains(*projectile.target_layers, PLAYER_LAYER))
+        {
+            return;
+        }
+
+        const vec2 projectile_offset = position - (vec2)projectile_transform.position;
+        const vec2 projectile_direction = (vec2)projectile.direction;
+        const float approach_distance = dot(projectile_offset, projectile_direction);
+
+        if (approach_distance <= 0.0f || approach_distance > DODGE_DISTANCE)
+        {
+            return;
+        }
+
+        const vec2 miss_offset = projectile_offset - (projectile_direction * approach_distance);
+        const float miss_distance = length(miss_offset);
+
+        if (miss_distance > DODGE_WIDTH)
+        {
+            return;
+        }
+
+
+        // Step to whichever side of the projectile's path the player is already on.
+        const vec2 dodge_side =
+            miss_distance > 0.0f
+            ? miss_offset / miss_distance
+            : vec2(-projectile_direction.y, projectile_direction.x);
+
+        dodge_direction += dodge_side * (1.0f - (approach_distance / DODGE_DISTANCE));
+    });
+
+    return dodge_direction;
+}
+
+
+static void update_bot(const vec3 & player_position, vec3 & move_direction, vec3 & look_direction, bool & firing)
+{
+    static const float REPLAN_INTERVAL = 0.5f;
+    static const float ENGAGE_DISTANCE = 3.0f;
+    static const float WAYPOINT_DISTANCE = 0.1f;
+    static const float DODGE_WEIGHT = 2.0f;
+
+    const vec2 position = (vec2)player_position;
+    const int room = get_room(player_position);
+
+    if (room == -1)
+    {
+        return;
+    }
+
+    const int room_enemy_count = get_room_enemy_count(room);
+    const Transform * nearest_enemy = get_nearest_enemy(room, position);
+    vector<ivec2> & path = bot_state.path;
+    int & path_index = bot_state.path_index;
+
+
+    // Replan on entering a room, when an enemy dies, and periodically so enemies that move are followed and unreachable
+    // targets are retried without searching every frame.
+    bool replan =
+        room_enemy_count != bot_state.room_enemy_count ||
+        get_time() >= bot_state.plan_time + REPLAN_INTERVAL;
+
+    if (room != bot_state.room)
+    {
+        bot_state.room = room;
+        bot_state.room_visits[room]++;
+        replan = true;
+    }
+
+    if (replan)
+    {
+        bot_state.room_enemy_count = room_enemy_count;
+        plan_bot_path(room, position);
+    }
+
+
+    // Follow the path, holding position once close enough to the nearest enemy to fight it.
+    while (path_index < (int)path.size() &&
+           distance(position, get_room_tile_position(path[path_index])) < WAYPOINT_DISTANCE)
+    {
+        path_index++;
+    }
+
+    if (path_index < (int)path.size() &&
+        (nearest_enemy == nullptr ||
+         distance(position, (vec2)nearest_enemy->position) > ENGAGE_DISTANCE))
+    {
+        const vec2 waypoint_direction = get_room_tile_position(path[path_index]) - position;
+        move_direction = vec3(normalize(waypoint_direction), 0.0f);
+    }
+
+    const vec2 dodge_direction = get_bot_dodge_direction(position) * DODGE_WEIGHT;
+    move_direction += vec3(dodge_direction, 0.0f);
+
+
+    // Aim at the nearest enemy and keep firing until the room is clear.
+    if (nearest_enemy != nullptr)
+    {
+        look_direction = nearest_enemy->position - player_position;
+        look_direction.z = 0.0f;
+        firing = true;
+    }
+    else
+    {
+        look_direction = move_direction;
+        firing = false;
+    }
 }
 
 
@@ -175,23 +502,38 @@ void player_controller_subscribe(Entity entity)
     }
 
     Entity camera = get_entity("camera");
-    transform = (Transform *)get_component(entity, "transform");
-    dimensions = (Dimensions *)get_component(entity, "dimensions");
-    orientation_handler = (Orientation_Handler *)get_component(entity, "orientation_handler");
-    player_controller = (Player_Controller *)get_component(entity, "player_controller");
-    camera_transform = (Transform *)get_component(camera, "transform");
-    camera_origin = &((Dimensions *)get_component(camera, "dimensions"))->origin;
+    player = entity;
+    transform = component<Transform>(entity);
+    dimensions = component<Dimensions>(entity);
+    orientation_handler = component<Orientation_Handler>(entity);
+    player_controller = component<Player_Controller>(entity);
+    camera_transform = component<Transform>(camera);
+    camera_origin = &component<Dimensions>(camera)->origin;
     pixels_per_unit = get_pixels_per_unit();
 
 
     // Set player fire handler to controller button 5.
     set_controller_button_handler(FIRE_HANDLER_ID, DS4_Buttons::R1, Button_Actions::PRESS, fire);
+
+
+    // The bot's room visits only make sense for the floor they were made on.
+    if (player_controller->mode == Player_Controller::Modes::BOT)
+    {
+        reset_bot();
+        add_floor_generated_handler(BOT_FLOOR_GENERATED_HANDLER_ID, reset_bot);
+    }
 }
 
 
 void player_controller_unsubscribe(Entity /*entity*/)
 {
     remove_controller_button_handler(FIRE_HANDLER_ID);
+
+    if (player_controller->mode == Player_Controller::Modes::BOT)
+    {
+        remove_floor_generated_handler(BOT_FLOOR_GENERATED_HANDLER_ID);
+    }
+
     transform = nullptr;
     dimensions = nullptr;
     orientation_handler = nullptr;
@@ -213,6 +555,7 @@ void player_controller_update()
     vec3 & player_position = transform->position;
     vec3 move_direction;
     vec3 look_direction;
+    bool firing = false;
 
     if (player_controller->mode == Player_Controller::Modes::CONTROLLER)
     {
@@ -240,6 +583,8 @@ void player_controller_update()
             fabsf(right_stick_direction.y) > stick_dead_zone
             ? right_stick_direction
             : move_direction;
+
+        firing = get_mouse_button_action(Mouse_Buttons::LEFT) == Button_Actions::PRESS;
     }
     else if (player_controller->mode == Player_Controller::Modes::KEYBOARD_MOUSE)
     {
@@ -265,12 +610,18 @@ void player_controller_update()
         const vec2 mouse_direction = normalize(mouse_world_position - (vec2)player_position);
         look_direction.x = mouse_direction.x;
         look_direction.y = mouse_direction.y;
+        firing = get_mouse_button_action(Mouse_Buttons::LEFT) == Button_Actions::PRESS;
+    }
+    else if (player_controller->mode == Player_Controller::Modes::BOT)
+    {
+        update_bot(player_position, move_direction, look_direction, firing);
     }
 
 
     if (move_direction.x != 0.0f || move_direction.y != 0.0f)
     {
         player_position += normalize(move_direction) * player_controller->speed * delta_time;
+        set_depth_dirty(player);
     }
 
 
@@ -288,21 +639,10 @@ void player_controller_update()
     }
 
 
-    // Handle firing.
-    static const float FIRE_COOLDOWN = 0.4f;
-    static float last_fire_time = -FIRE_COOLDOWN;
-
-    float time = get_time();
-
-    if (time >= last_fire_time + FIRE_COOLDOWN)
+    // Handle firing, which the player's bullet pattern limits to its rate.
+    if (firing)
     {
-        Button_Actions fire_button_action = get_mouse_button_action(Mouse_Buttons::LEFT);
-
-        if (fire_button_action == Button_Actions::PRESS)
-        {
-            fire();
-            last_fire_time = time;
-        }
+        fire();
     }
 }
 
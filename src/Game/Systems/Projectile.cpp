@@ -3,29 +3,36 @@
 #include <map>
 #include <string>
 #include <vector>
+#include <functional>
 #include "Nito/Engine.hpp"
 #include "Nito/Components.hpp"
 #include "Nito/Collider_Component.hpp"
+#include "Nito/APIs/Scene.hpp"
 #include "Nito/APIs/Window.hpp"
 #include "Cpp_Utils/Map.hpp"
 #include "Cpp_Utils/Vector.hpp"
 #include "Cpp_Utils/Collection.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Components.hpp"
 #include "Game/Systems/Health.hpp"
 #include "Game/APIs/Audio_Manager.hpp"
+#include "Game/APIs/Timer_Wheel.hpp"
+#include "Game/Systems/Depth_Handler.hpp"
 
 
 using std::map;
 using std::string;
 using std::vector;
+using std::function;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
-using Nito::has_component;
 using Nito::flag_entity_for_deletion;
 
+// Nito/APIs/Scene.hpp
+using Nito::load_blueprint;
+
 // Nito/Engine.hpp
 using Nito::get_time_scale;
 
@@ -61,7 +68,7 @@ struct Projectile_State
 {
     Transform * transform;
     const Projectile * projectile;
-    float time_elapsed;
+    Timer_Handle expiry;
 };
 
 
@@ -70,9 +77,14 @@ struct Projectile_State
 // Data
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const vector<string> NO_TARGET_LAYERS;
 static map<Entity, Projectile_State> entity_states;
 
 
+// The volley whose projectiles are being loaded, if any.
+static const Projectile_Volley * spawning_volley = nullptr;
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Interface
@@ -80,24 +92,37 @@ static map<Entity, Projectile_State> entity_states;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void projectile_subscribe(Entity entity)
 {
-    auto projectile = (Projectile *)get_component(entity, "projectile");
+    auto projectile = component<Projectile>(entity);
+    projectile->target_layers = &NO_TARGET_LAYERS;
+
+
+    // Apply the settings of the volley the projectile is being spawned for before its expiry is scheduled.
+    if (spawning_volley != nullptr)
+    {
+        projectile->target_layers = spawning_volley->target_layers;
+        projectile->duration = spawning_volley->duration;
+        projectile->damage *= spawning_volley->damage_modifier;
+    }
 
     entity_states[entity] =
     {
-        (Transform *)get_component(entity, "transform"),
+        component<Transform>(entity),
         projectile,
-        0.0f,
+        schedule_timer(projectile->duration, [=]() -> void
+        {
+            flag_entity_for_deletion(entity);
+        }),
     };
 
 
     // Setup collision handler to damage entity if its layer is in projectile's target layers.
-    auto collider = (Collider *)get_component(entity, "collider");
+    auto collider = component<Collider>(entity);
 
     collider->collision_handler = [=](Entity collision_entity) -> void
     {
-        if (has_component(collision_entity, "layers"))
+        if (has<Layers>(collision_entity))
         {
-            const auto collision_layers = (vector<string> *)get_component(collision_entity, "layers");
+            const auto collision_layers = component<Layers>(collision_entity);
 
             for (const string & collision_layer : *collision_layers)
             {
@@ -111,7 +136,7 @@ void projectile_subscribe(Entity entity)
             // If projectile has hit a target, damage target and destroy projectile.
             for (const string & collision_layer : *collision_layers)
             {
-                if (contains(projectile->target_layers, collision_layer))
+                if (contains(*projectile->target_layers, collision_layer))
                 {
                     damage_entity(collision_entity, projectile->damage);
                     flag_entity_for_deletion(entity);
@@ -127,15 +152,12 @@ void projectile_subscribe(Entity entity)
             }
         }
     };
-
-
-    // Play sound for projectile
-    play_sound("resources/audio/laser.wav", 0);
 }
 
 
 void projectile_unsubscribe(Entity entity)
 {
+    cancel_timer(entity_states.at(entity).expiry);
     remove(entity_states, entity);
 }
 
@@ -147,19 +169,46 @@ void projectile_update()
     for_each(entity_states, [=](Entity entity, Projectile_State & entity_state) -> void
     {
         const Projectile * projectile = entity_state.projectile;
-        float & time_elapsed = entity_state.time_elapsed;
+        entity_state.transform->position += projectile->speed * projectile->direction * delta_time;
+        set_depth_dirty(entity);
+    });
+}
 
 
-        // If projectile's duration has expired, flag it for deletion.
-        if (time_elapsed > projectile->duration)
-        {
-            flag_entity_for_deletion(entity);
-            return;
-        }
+// Loads every projectile in a volley from its blueprint with the volley's shared settings, then positions and aims each
+// one. The volley plays a single sound however many projectiles it spawns.
+void projectile_spawn_volley(const Projectile_Volley & volley, const Projectile_Spawn * spawns, int spawn_count)
+{
+    static const int LASER_SOUND = load_sound("resources/audio/laser.wav");
 
+    if (spawn_count == 0)
+    {
+        return;
+    }
 
-        entity_state.transform->position += projectile->speed * projectile->direction * delta_time;
-        time_elapsed += delta_time;
+    spawning_volley = &volley;
+
+    for (int i = 0; i < spawn_count; i++)
+    {
+        const Projectile_Spawn & spawn = spawns[i];
+        const Entity projectile_entity = load_blueprint(volley.blueprint_name);
+        Projectile_State & entity_state = entity_states.at(projectile_entity);
+        Projectile * projectile = component<Projectile>(projectile_entity);
+        entity_state.transform->position = spawn.origin;
+        projectile->direction = spawn.direction;
+        projectile->speed *= spawn.speed_modifier;
+    }
+
+    spawning_volley = nullptr;
+    play_sound(LASER_SOUND, 0, 0);
+}
+
+
+void projectile_iterate(const function<void(const Transform &, const Projectile &)> & callback)
+{
+    for_each(entity_states, [&](Entity /*entity*/, const Projectile_State & entity_state) -> void
+    {
+        callback(*entity_state.transform, *entity_state.projectile);
     });
 }
 
@@ -7,6 +7,8 @@
 #include "Nito/APIs/Input.hpp"
 #include "Nito/APIs/Graphics.hpp"
 
+#include "Game/Component_Types.hpp"
+
 
 // glm/glm.hpp
 using glm::vec3;
@@ -14,7 +16,6 @@ using glm::dvec2;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 
 // Nito/Components.hpp
 using Nito::UI_Transform;
@@ -51,7 +52,7 @@ void reticle_subscribe(Entity entity)
     set_mouse_visible(false);
 
 
-    ui_position = &((UI_Transform *)get_component(entity, "ui_transform"))->position;
+    ui_position = &component<UI_Transform>(entity)->position;
     mouse_position = &get_mouse_position();
     ui_position->z = -10;
 }
@@ -10,6 +10,7 @@
 #include "Cpp_Utils/Map.hpp"
 #include "Cpp_Utils/String.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Components.hpp"
 
 
@@ -23,7 +24,6 @@ using glm::vec3;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 
 // Nito/APIs/Components.hpp
 using Nito::Sprite;
@@ -100,12 +100,12 @@ static void unset_door_lock(Entity entity)
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void room_exit_handler_subscribe(Entity entity)
 {
-    auto sprite = (Sprite *)get_component(entity, "sprite");
+    auto sprite = component<Sprite>(entity);
 
     entity_states[entity] =
     {
-        (Room_Exit *)get_component(entity, "room_exit"),
-        (Transform *)get_component(entity, "transform"),
+        component<Room_Exit>(entity),
+        component<Transform>(entity),
         sprite,
         sprite->texture_path,
     };
@@ -165,7 +165,7 @@ void room_exit_handler_set_locked(Entity entity, bool locked)
             }
             else
             {
-                door_lock = (Transform *)get_component(load_blueprint("door_lock_tile"), "transform");
+                door_lock = component<Transform>(load_blueprint("door_lock_tile"));
             }
 
             used_door_lock_transforms[entity] = door_lock;
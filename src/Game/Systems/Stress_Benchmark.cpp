@@ -0,0 +1,433 @@
+#include "Game/Systems/Stress_Benchmark.hpp"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <stdexcept>
+#include <glm/glm.hpp>
+#include "Nito/Components.hpp"
+#include "Nito/APIs/Scene.hpp"
+#include "Nito/APIs/Window.hpp"
+#include "Cpp_Utils/JSON.hpp"
+
+#include "Game/Component_Types.hpp"
+#include "Game/Utilities.hpp"
+#include "Game/APIs/Floor_Manager.hpp"
+#include "Game/APIs/Enemy_Manager.hpp"
+#include "Game/APIs/Update_Profiler.hpp"
+#include "Game/APIs/Allocation_Tracker.hpp"
+#include "Game/APIs/Frame_Arena.hpp"
+#include "Game/Systems/Projectile.hpp"
+#include "Game/Systems/Tile_Turret.hpp"
+#include "Game/Systems/Wall_Launcher.hpp"
+#include "Game/Systems/Boss.hpp"
+#include "Game/Systems/Game_Manager.hpp"
+
+
+using std::string;
+using std::vector;
+using std::ofstream;
+using std::runtime_error;
+
+// glm/glm.hpp
+using glm::vec3;
+using glm::ivec2;
+using glm::min;
+using glm::max;
+using glm::normalize;
+
+// Nito/APIs/ECS.hpp
+using Nito::Entity;
+using Nito::flag_entity_for_deletion;
+
+// Nito/Components.hpp
+using Nito::Transform;
+
+// Nito/APIs/Scene.hpp
+using Nito::load_blueprint;
+
+// Nito/APIs/Window.hpp
+using Nito::get_delta_time;
+using Nito::close_window;
+
+// Cpp_Utils/JSON.hpp
+using Cpp_Utils::JSON;
+using Cpp_Utils::read_json_file;
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// How many of each enemy, indexed by Enemies, and how many projectiles are kept in the benchmark room at one level of
+// the ramp.
+struct Stress_Level
+{
+    int enemy_counts[(int)Enemies::NONE];
+    int projectile_count;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const string SETTINGS_PATH("resources/data/stress_benchmark.json");
+static const vector<string> TARGET_LAYERS { "player" };
+static const Projectile_Volley PROJECTILE_VOLLEY { "projectile_red_orb", &TARGET_LAYERS, 2.0f, 1.0f };
+
+
+// Indexed by Enemies.
+static const char * const ENEMY_COUNT_NAMES[(int)Enemies::NONE]
+{
+    "turrets",
+    "tile_turrets",
+    "wall_launchers",
+    "bosses",
+};
+
+
+static vector<Stress_Level> stress_levels;
+static int warmup_frames;
+static int sample_frames;
+static string report_path;
+static bool benchmarking;
+static int room;
+static ivec2 room_tile_origin;
+static ivec2 room_tile_bound;
+static int level_index;
+static int level_frame;
+static double level_frame_time;
+static Allocation_Counts level_start_allocation_counts;
+static int enemy_counts[(int)Enemies::NONE];
+static JSON report;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Finds the room tile coordinates spanned by the benchmark room's sections.
+static void find_room_tile_bounds()
+{
+    const ivec2 room_tile_size(get_room_tile_width(), get_room_tile_height());
+    room_tile_origin = room_tile_size * ivec2(get_floor_size());
+    room_tile_bound = ivec2(0);
+
+    iterate_rooms([&](int x, int y, int & room_id) -> void
+    {
+        if (room_id == room)
+        {
+            room_tile_origin = min(room_tile_origin, ivec2(x, y) * room_tile_size);
+            room_tile_bound = max(room_tile_bound, (ivec2(x, y) + ivec2(1)) * room_tile_size);
+        }
+    });
+}
+
+
+static Stress_Level parse_stress_level(const JSON & stress_level_data)
+{
+    Stress_Level stress_level;
+
+    for (int i = 0; i < (int)Enemies::NONE; i++)
+    {
+        stress_level.enemy_counts[i] = stress_level_data.at(ENEMY_COUNT_NAMES[i]);
+    }
+
+    stress_level.projectile_count = stress_level_data.at("projectiles");
+    return stress_level;
+}
+
+
+// Spawns one batch of an enemy in the benchmark room, returning nothing once the room has no space left for it. Wall
+// launchers fill every free wall segment at once, so their count is capped by the room's walls.
+static vector<Entity> spawn_stress_enemy(Enemies enemy)
+{
+    if (enemy == Enemies::TURRET)
+    {
+        const Entity turret = load_blueprint("turret");
+        ivec2 coordinates;
+
+        if (!occupy_random_floor_tile(turret, room, coordinates))
+        {
+            flag_entity_for_deletion(turret);
+            return {};
+        }
+
+        component<Transform>(turret)->position = vec3(coordinates.x, coordinates.y, 0) * get_room_tile_unit_size();
+        return { turret };
+    }
+    else if (enemy == Enemies::TILE_TURRET)
+    {
+        return get_free_floor_tile_count(room) > 0 ? tile_turret_generate(room, 0, 0, 0) : vector<Entity>();
+    }
+    else if (enemy == Enemies::WALL_LAUNCHER)
+    {
+        return wall_launcher_generate(room, 0, 0, 0);
+    }
+    else
+    {
+        return { boss_generate(room, room_tile_origin.x, room_tile_origin.y) };
+    }
+}
+
+
+static void spawn_stress_level(const Stress_Level & stress_level)
+{
+    for (int i = 0; i < (int)Enemies::NONE; i++)
+    {
+        const Enemies enemy = (Enemies)i;
+
+        while (enemy_counts[i] < stress_level.enemy_counts[i])
+        {
+            const vector<Entity> enemy_entities = spawn_stress_enemy(enemy);
+
+            if (enemy_entities.empty())
+            {
+                break;
+            }
+
+            for (const Entity enemy_entity : enemy_entities)
+            {
+                track_enemy(enemy_entity, enemy, room);
+            }
+
+            enemy_counts[i] += enemy_entities.size();
+        }
+    }
+
+
+    // Enemy blueprints start disabled until their room is entered, and the player is already in the benchmark room.
+    game_manager_refresh_room_flags(room);
+    level_frame = 0;
+    level_frame_time = 0.0;
+}
+
+
+// Tops the projectiles in flight back up to the level's count, firing new ones from random tiles inside the room's
+// walls as a single volley.
+static void fire_stress_projectiles(int projectile_count)
+{
+    int current_projectile_count = 0;
+    Frame_Arena_Scope frame_arena_scope;
+    Frame_Vector<Projectile_Spawn> spawns;
+
+    projectile_iterate([&](const Transform & /*transform*/, const Projectile & /*projectile*/) -> void
+    {
+        current_projectile_count++;
+    });
+
+    for (int i = current_projectile_count; i < projectile_count; i++)
+    {
+        const ivec2 origin_coordinates(
+            random(room_tile_origin.x + 1, room_tile_bound.x - 1),
+            random(room_tile_origin.y + 1, room_tile_bound.y - 1));
+
+        const vec3 origin(get_room_tile_position(origin_coordinates), 0.0f);
+        const vec3 direction(random(-1.0f, 1.0f), random(-1.0f, 1.0f), 0.0f);
+
+        if (direction.x != 0.0f || direction.y != 0.0f)
+        {
+            spawns.push_back({ origin, normalize(direction), 1.0f });
+        }
+    }
+
+    projectile_spawn_volley(PROJECTILE_VOLLEY, spawns.data(), spawns.size());
+}
+
+
+static void record_stress_level(const Stress_Level & stress_level)
+{
+    JSON level_report;
+    JSON update_handler_times = JSON::object();
+    JSON update_handler_allocations = JSON::object();
+    int entity_count = stress_level.projectile_count;
+
+    for (int i = 0; i < (int)Enemies::NONE; i++)
+    {
+        level_report[ENEMY_COUNT_NAMES[i]] = enemy_counts[i];
+        entity_count += enemy_counts[i];
+    }
+
+    iterate_update_profiles([&](const Update_Profile & update_profile) -> void
+    {
+        if (update_profile.sample_count > 0)
+        {
+            update_handler_times[update_profile.name] =
+                (update_profile.total_time * 1000.0) / update_profile.sample_count;
+
+            update_handler_allocations[update_profile.name] =
+                (double)update_profile.allocation_count / update_profile.sample_count;
+        }
+    });
+
+    const double frame_time = (level_frame_time * 1000.0) / sample_frames;
+    level_report["projectiles"] = stress_level.projectile_count;
+    level_report["entities"] = entity_count;
+    level_report["frame_ms"] = frame_time;
+    level_report["update_handler_ms"] = update_handler_times;
+
+
+    // Allocations are only reported when they are being tracked, so a steady-state allocation budget can be checked
+    // against them.
+    if (is_allocation_tracking())
+    {
+        const Allocation_Counts allocation_counts = get_allocation_counts();
+
+        level_report["frame_allocations"] =
+            (double)(allocation_counts.allocation_count - level_start_allocation_counts.allocation_count) /
+            sample_frames;
+
+        level_report["frame_allocated_bytes"] =
+            (double)(allocation_counts.allocated_bytes - level_start_allocation_counts.allocated_bytes) /
+            sample_frames;
+
+        level_report["update_handler_allocations"] = update_handler_allocations;
+    }
+
+    report["levels"].push_back(level_report);
+}
+
+
+static void finish_stress_benchmark()
+{
+    if (is_allocation_tracking())
+    {
+        JSON component_footprints = JSON::object();
+
+        iterate_component_footprints([&](const Component_Footprint & component_footprint) -> void
+        {
+            component_footprints[component_footprint.type] =
+            {
+                { "live_count" , component_footprint.live_count },
+                { "live_bytes" , component_footprint.live_bytes },
+            };
+        });
+
+        report["component_footprints"] = component_footprints;
+    }
+
+    ofstream report_file(report_path);
+
+    if (!(report_file << report.dump(4) << '\n'))
+    {
+        throw runtime_error("ERROR: failed to write stress benchmark report to \"" + report_path + "\"!");
+    }
+
+    benchmarking = false;
+    set_update_profiling(false);
+    close_window();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void stress_benchmark_subscribe(Entity /*entity*/)
+{
+    const JSON settings = read_json_file(SETTINGS_PATH);
+    stress_levels.clear();
+
+    for (const JSON & stress_level_data : settings.at("levels"))
+    {
+        stress_levels.push_back(parse_stress_level(stress_level_data));
+    }
+
+    if (stress_levels.empty())
+    {
+        throw runtime_error("ERROR: stress benchmark has no levels!");
+    }
+
+    warmup_frames = settings.at("warmup_frames");
+    sample_frames = settings.at("sample_frames");
+    report_path = settings.at("report_path").get<string>();
+
+    if (sample_frames < 1)
+    {
+        throw runtime_error("ERROR: stress benchmark must sample at least 1 frame per level!");
+    }
+
+
+    // The floor may not be generated until the rest of the scene is loaded, so the benchmark starts on its first
+    // update.
+    benchmarking = true;
+    level_index = -1;
+    report = { { "levels", JSON::array() } };
+
+    for (int & enemy_count : enemy_counts)
+    {
+        enemy_count = 0;
+    }
+}
+
+
+void stress_benchmark_unsubscribe(Entity /*entity*/)
+{
+    benchmarking = false;
+    set_update_profiling(false);
+}
+
+
+void stress_benchmark_update()
+{
+    if (!benchmarking)
+    {
+        return;
+    }
+
+
+    // Every level is run in the spawn room, as the player starts there and its enemies are enabled.
+    if (level_index == -1)
+    {
+        room = get_spawn_room_id();
+        find_room_tile_bounds();
+        level_index = 0;
+        set_update_profiling(true);
+        spawn_stress_level(stress_levels[level_index]);
+    }
+
+    const Stress_Level & stress_level = stress_levels[level_index];
+    fire_stress_projectiles(stress_level.projectile_count);
+
+
+    // Delta time is the length of the previous frame, so frame times lag the update profiles by a frame: both cover the
+    // sample frames once the frame after the last one starts.
+    if (level_frame > warmup_frames)
+    {
+        level_frame_time += get_delta_time();
+    }
+
+    if (level_frame == warmup_frames)
+    {
+        reset_update_profiles();
+        level_start_allocation_counts = get_allocation_counts();
+    }
+
+    if (level_frame < warmup_frames + sample_frames)
+    {
+        level_frame++;
+        return;
+    }
+
+    record_stress_level(stress_level);
+
+    if (++level_index == (int)stress_levels.size())
+    {
+        finish_stress_benchmark();
+        return;
+    }
+
+    spawn_stress_level(stress_levels[level_index]);
+}
+
+
+} // namespace Game
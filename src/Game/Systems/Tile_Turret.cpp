@@ -7,15 +7,16 @@
 #include "Nito/Components.hpp"
 #include "Nito/Collider_Component.hpp"
 #include "Nito/APIs/Scene.hpp"
-#include "Nito/APIs/Window.hpp"
 #include "Cpp_Utils/Map.hpp"
 #include "Cpp_Utils/Vector.hpp"
 #include "Cpp_Utils/Collection.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Utilities.hpp"
 #include "Game/Components.hpp"
 #include "Game/APIs/Floor_Manager.hpp"
-#include "Game/Systems/Turret.hpp"
+#include "Game/APIs/Timer_Wheel.hpp"
+#include "Game/Systems/Depth_Handler.hpp"
 
 
 using std::map;
@@ -28,14 +29,10 @@ using glm::vec3;
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
 using Nito::get_entity;
-using Nito::get_component;
 
 // Nito/APIs/Scene.hpp
 using Nito::load_blueprint;
 
-// Nito/APIs/Window.hpp
-using Nito::get_delta_time;
-
 // Nito/Engine.hpp
 using Nito::get_time_scale;
 
@@ -46,13 +43,9 @@ using Nito::Sprite;
 // Nito/Collider_Component.hpp
 using Nito::Collider;
 
-// Cpp_Utils/Map.hpp
-using Cpp_Utils::contains_key;
+// Cpp_Utils/Map.hpp & Cpp_Utils/Vector.hpp
 using Cpp_Utils::remove;
 
-// Cpp_Utils/Vector.hpp
-using Cpp_Utils::contains;
-
 // Cpp_Utils/Collection.hpp
 using Cpp_Utils::for_each;
 
@@ -66,6 +59,15 @@ namespace Game
 // Data Structures
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Tile turrets in the same room pop up and down together, each room on its own clock.
+struct Tile_Turret_Room
+{
+    vector<Entity> tile_turrets;
+    Timer_Handle timer;
+    bool up;
+};
+
+
 struct Tile_Turret_State
 {
     vec3 * position;
@@ -75,6 +77,7 @@ struct Tile_Turret_State
     bool * collider_enabled;
     bool * enemy_projectile_launcher_enabled;
     const vec3 * target_position;
+    const bool * up;
     int room;
 };
 
@@ -84,8 +87,10 @@ struct Tile_Turret_State
 // Data
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const float UP_TIME = 3;
+static const float DOWN_TIME = 2;
 static map<Entity, Tile_Turret_State> entity_states;
-static map<int, vector<ivec2>> room_floor_tiles;
+static map<int, Tile_Turret_Room> rooms;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -93,33 +98,37 @@ static map<int, vector<ivec2>> room_floor_tiles;
 // Utilities
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void set_random_position(Tile_Turret_State & entity_state)
+static void set_random_position(Entity entity)
 {
-    const int room = entity_state.room;
-    vector<ivec2> turret_tiles;
-    const map<int, map<Entity, ivec2>> & turret_room_tiles = get_turret_room_tiles();
+    Tile_Turret_State & entity_state = entity_states.at(entity);
+    ivec2 tile;
 
-    if (contains_key(turret_room_tiles, room))
+
+    // Leave tile turret where it is if every floor tile in its room is occupied.
+    if (occupy_random_floor_tile(entity, entity_state.room, tile))
     {
-        for_each(turret_room_tiles.at(room), [&](Entity /*turret*/, const ivec2 & turret_tile) -> void
-        {
-            turret_tiles.emplace_back(turret_tile.x, turret_tile.y);
-        });
+        *entity_state.position = vec3(tile.x, tile.y, 0) * get_room_tile_unit_size();
+        set_depth_dirty(entity);
     }
+}
 
-    const vector<ivec2> & tiles = room_floor_tiles.at(entity_state.room);
-    const ivec2 * tile;
 
+static void toggle_room(int room)
+{
+    Tile_Turret_Room & tile_turret_room = rooms.at(room);
+    tile_turret_room.up = !tile_turret_room.up;
 
-    // Ensure tile turret does not overlap a turret.
-    do
+    if (tile_turret_room.up)
     {
-        tile = &tiles[random(0, tiles.size())];
+        for_each(tile_turret_room.tile_turrets, set_random_position);
     }
-    while (contains(turret_tiles, *tile));
-
 
-    *entity_state.position = vec3(tile->x, tile->y, 0) * get_room_tile_unit_size();
+    tile_turret_room.timer = schedule_timer(
+        tile_turret_room.up ? UP_TIME : DOWN_TIME,
+        [=]() -> void
+        {
+            toggle_room(room);
+        });
 }
 
 
@@ -128,34 +137,18 @@ void set_random_position(Tile_Turret_State & entity_state)
 // Interface
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void tile_turret_init()
-{
-    add_floor_generated_handler("tile_turret", [&]() -> void
-    {
-        room_floor_tiles.clear();
-
-        iterate_room_tiles([&](int x, int y, const Tile & tile) -> void
-        {
-            if (tile.type == Tile_Types::FLOOR)
-            {
-                room_floor_tiles[tile.room].emplace_back(x, y);
-            }
-        });
-    });
-}
-
-
 void tile_turret_subscribe(Entity entity)
 {
     entity_states[entity] =
     {
-        &((Transform *)get_component(entity, "transform"))->position,
-        &((Orientation_Handler *)get_component(entity, "orientation_handler"))->look_direction,
-        (bool *)get_component(entity, "enemy_enabled"),
-        &((Sprite *)get_component(entity, "sprite"))->render,
-        &((Collider *)get_component(entity, "collider"))->enabled,
-        &((Enemy_Projectile_Launcher *)get_component(entity, "enemy_projectile_launcher"))->enabled,
-        &((Transform *)get_component(get_entity("player"), "transform"))->position,
+        &component<Transform>(entity)->position,
+        &component<Orientation_Handler>(entity)->look_direction,
+        component<Enemy_Enabled>(entity),
+        &component<Sprite>(entity)->render,
+        &component<Collider>(entity)->enabled,
+        &component<Enemy_Projectile_Launcher>(entity)->enabled,
+        &component<Transform>(get_entity("player"))->position,
+        nullptr,
         -1,
     };
 }
@@ -163,46 +156,36 @@ void tile_turret_subscribe(Entity entity)
 
 void tile_turret_unsubscribe(Entity entity)
 {
+    const int room = entity_states.at(entity).room;
+
+
+    // Stop the room's clock once its last tile turret is gone.
+    if (room != -1)
+    {
+        Tile_Turret_Room & tile_turret_room = rooms.at(room);
+        remove(tile_turret_room.tile_turrets, entity);
+
+        if (tile_turret_room.tile_turrets.empty())
+        {
+            cancel_timer(tile_turret_room.timer);
+            remove(rooms, room);
+        }
+    }
+
     remove(entity_states, entity);
+    release_floor_tile(entity);
 }
 
 
 void tile_turret_update()
 {
-    static const float UP_TIME = 3;
-    static const float DOWN_TIME = 2;
-    static bool up = false;
-    static float time = 0;
-
-
-    // Don't update when game is paused or no entities are subscribed.
-    if (entity_states.size() == 0 || get_time_scale() < 1)
+    // Don't update when game is paused.
+    if (get_time_scale() < 1)
     {
         return;
     }
 
 
-    time -= get_delta_time();
-
-    if (time <= 0)
-    {
-        if (up)
-        {
-            time = DOWN_TIME;
-        }
-        else
-        {
-            time = UP_TIME;
-
-            for_each(entity_states, [&](Entity /*entity*/, Tile_Turret_State & entity_state) -> void
-            {
-                set_random_position(entity_state);
-            });
-        }
-
-        up = !up;
-    }
-
     for_each(entity_states, [&](Entity /*entity*/, Tile_Turret_State & entity_state) -> void
     {
         if (!*entity_state.enemy_enabled)
@@ -210,6 +193,7 @@ void tile_turret_update()
             return;
         }
 
+        const bool up = *entity_state.up;
         *entity_state.look_direction = *entity_state.target_position - *entity_state.position;
         *entity_state.render = up;
         *entity_state.collider_enabled = up;
@@ -218,16 +202,31 @@ void tile_turret_update()
 }
 
 
-vector<Entity> tile_turret_generate(int room, int /*room_origin_x*/, int /*room_origin_y*/)
+vector<Entity> tile_turret_generate(int room, int /*room_origin_x*/, int /*room_origin_y*/, int /*layout*/)
 {
     vector<Entity> tile_turrets;
+    Tile_Turret_Room & tile_turret_room = rooms[room];
 
     for (int i = 0; i < 2; i++)
     {
         const Entity tile_turret = load_blueprint("tile_turret");
         tile_turrets.push_back(tile_turret);
+        tile_turret_room.tile_turrets.push_back(tile_turret);
         Tile_Turret_State & entity_state = entity_states[tile_turret];
         entity_state.room = room;
+        entity_state.up = &tile_turret_room.up;
+    }
+
+
+    // Start the room's clock with its tile turrets down, popping them up on the next tick.
+    if (!is_timer_pending(tile_turret_room.timer))
+    {
+        tile_turret_room.up = false;
+
+        tile_turret_room.timer = schedule_timer(0.0f, [=]() -> void
+        {
+            toggle_room(room);
+        });
     }
 
     return tile_turrets;
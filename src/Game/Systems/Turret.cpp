@@ -1,19 +1,28 @@
 #include "Game/Systems/Turret.hpp"
 
 #include <map>
+#include <vector>
+#include <string>
+#include <functional>
+#include <stdexcept>
 #include "Nito/Components.hpp"
 #include "Nito/APIs/Scene.hpp"
 #include "Cpp_Utils/Map.hpp"
 #include "Cpp_Utils/Collection.hpp"
 #include "Cpp_Utils/JSON.hpp"
+#include "Cpp_Utils/String.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Components.hpp"
 #include "Game/Utilities.hpp"
 #include "Game/APIs/Floor_Manager.hpp"
+#include "Game/APIs/Data_Reloader.hpp"
 
 
 using std::map;
 using std::vector;
+using std::function;
+using std::runtime_error;
 
 // glm/glm.hpp
 using glm::vec3;
@@ -21,7 +30,6 @@ using glm::ivec2;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 using Nito::get_entity;
 
 // Nito/Components.hpp
@@ -38,7 +46,9 @@ using Cpp_Utils::for_each;
 
 // Cpp_Utils/JSON.hpp
 using Cpp_Utils::JSON;
-using Cpp_Utils::read_json_file;
+
+// Cpp_Utils/String.hpp
+using Cpp_Utils::to_string;
 
 
 namespace Game
@@ -65,8 +75,53 @@ struct Turret_State
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static map<Entity, Turret_State> entity_states;
-static vector<vector<JSON>> enemy_layouts;
-static map<int, map<Entity, ivec2>> room_tiles;
+static vector<vector<ivec2>> enemy_layouts;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static function<void()> load_enemy_layouts(const JSON & enemy_layouts_data)
+{
+    const int room_tile_width = get_room_tile_width();
+    const int room_tile_height = get_room_tile_height();
+    vector<vector<ivec2>> loaded_enemy_layouts;
+
+    for (const JSON & enemy_layout_data : enemy_layouts_data)
+    {
+        loaded_enemy_layouts.emplace_back();
+        vector<ivec2> & enemy_layout = loaded_enemy_layouts.back();
+
+        for (const JSON & enemy_position_data : enemy_layout_data)
+        {
+            const ivec2 enemy_position(enemy_position_data.at("x").get<int>(), enemy_position_data.at("y").get<int>());
+
+
+            // Enemies can only be placed on the floor inside a room's walls.
+            if (enemy_position.x < 1 || enemy_position.x > room_tile_width - 2 ||
+                enemy_position.y < 1 || enemy_position.y > room_tile_height - 2)
+            {
+                throw runtime_error(
+                    "ERROR: enemy layout position (" + to_string(enemy_position.x) + ", " +
+                    to_string(enemy_position.y) + ") is not inside a room!");
+            }
+
+            enemy_layout.push_back(enemy_position);
+        }
+    }
+
+    if (loaded_enemy_layouts.size() == 0)
+    {
+        throw runtime_error("ERROR: there must be at least 1 enemy layout!");
+    }
+
+    return [=]() -> void
+    {
+        enemy_layouts = loaded_enemy_layouts;
+    };
+}
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -76,7 +131,7 @@ static map<int, map<Entity, ivec2>> room_tiles;
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 void turret_init()
 {
-    enemy_layouts = read_json_file("resources/data/enemy_layouts.json").get<vector<vector<JSON>>>();
+    load_data_file("resources/data/enemy_layouts.json", load_enemy_layouts);
 }
 
 
@@ -84,10 +139,10 @@ void turret_subscribe(Entity entity)
 {
     entity_states[entity] =
     {
-        &((Transform *)get_component(entity, "transform"))->position,
-        &((Orientation_Handler *)get_component(entity, "orientation_handler"))->look_direction,
-        (bool *)get_component(entity, "enemy_enabled"),
-        &((Transform *)get_component(get_entity("player"), "transform"))->position,
+        &component<Transform>(entity)->position,
+        &component<Orientation_Handler>(entity)->look_direction,
+        component<Enemy_Enabled>(entity),
+        &component<Transform>(get_entity("player"))->position,
     };
 }
 
@@ -95,22 +150,7 @@ void turret_subscribe(Entity entity)
 void turret_unsubscribe(Entity entity)
 {
     remove(entity_states, entity);
-
-
-    // Remove room tile coordinates for entity.
-    for (auto & room_tile_data : room_tiles)
-    {
-        auto & room_tile_coordinates_data = room_tile_data.second;
-
-        for (const auto & room_tile_coordinates : room_tile_coordinates_data)
-        {
-            if (room_tile_coordinates.first == entity)
-            {
-                remove(room_tile_coordinates_data, entity);
-                return;
-            }
-        }
-    }
+    release_floor_tile(entity);
 }
 
 
@@ -128,16 +168,17 @@ void turret_update()
 }
 
 
-vector<Entity> turret_generate(int room, int room_origin_x, int room_origin_y)
+vector<Entity> turret_generate(int room, int room_origin_x, int room_origin_y, int layout)
 {
     vector<Entity> turrets;
-    const vector<JSON> & enemy_layout = enemy_layouts[random(0, enemy_layouts.size())];
+    // Layouts chosen before enemy_layouts.json was reloaded with fewer layouts wrap around to a valid one.
+    const vector<ivec2> & enemy_layout = enemy_layouts[layout % enemy_layouts.size()];
     const vec3 & room_tile_unit_size = get_room_tile_unit_size();
 
-    for (const JSON & enemy_position : enemy_layout)
+    for (const ivec2 & enemy_position : enemy_layout)
     {
-        const int enemy_position_x = room_origin_x + enemy_position["x"].get<int>();
-        const int enemy_position_y = room_origin_y + enemy_position["y"].get<int>();
+        const int enemy_position_x = room_origin_x + enemy_position.x;
+        const int enemy_position_y = room_origin_y + enemy_position.y;
 
         if (get_room_tile(enemy_position_x, enemy_position_y).type == Tile_Types::FLOOR)
         {
@@ -145,7 +186,7 @@ vector<Entity> turret_generate(int room, int room_origin_x, int room_origin_y)
             turrets.push_back(turret);
             vec3 * position = entity_states[turret].position;
             *position = vec3(enemy_position_x, enemy_position_y, 0) * room_tile_unit_size;
-            room_tiles[room][turret] = get_room_tile_coordinates(*position);
+            occupy_floor_tile(turret, ivec2(enemy_position_x, enemy_position_y));
         }
     }
 
@@ -153,9 +194,9 @@ vector<Entity> turret_generate(int room, int room_origin_x, int room_origin_y)
 }
 
 
-const map<int, map<Entity, ivec2>> & get_turret_room_tiles()
+int get_turret_layout_count()
 {
-    return room_tiles;
+    return enemy_layouts.size();
 }
 
 
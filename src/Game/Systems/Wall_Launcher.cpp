@@ -1,23 +1,29 @@
 #include "Game/Systems/Wall_Launcher.hpp"
 
 #include <map>
+#include <string>
+#include <stdexcept>
 #include <functional>
 #include <glm/glm.hpp>
 #include "Nito/Components.hpp"
 #include "Nito/Engine.hpp"
 #include "Nito/APIs/Scene.hpp"
 #include "Cpp_Utils/Map.hpp"
-#include "Cpp_Utils/Vector.hpp"
-#include "Cpp_Utils/Collection.hpp"
+#include "Cpp_Utils/String.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Utilities.hpp"
+#include "Game/World.hpp"
 #include "Game/Components.hpp"
 #include "Game/APIs/Floor_Manager.hpp"
+#include "Game/APIs/Frame_Arena.hpp"
+#include "Game/Systems/Depth_Handler.hpp"
 
 
 using std::vector;
 using std::map;
 using std::function;
+using std::runtime_error;
 
 // glm/glm.hpp
 using glm::vec3;
@@ -34,7 +40,6 @@ using Nito::get_time_scale;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::get_component;
 
 // Nito/APIs/Scene.hpp
 using Nito::load_blueprint;
@@ -43,11 +48,8 @@ using Nito::load_blueprint;
 using Cpp_Utils::remove;
 using Cpp_Utils::contains_key;
 
-// Cpp_Utils/Vector.hpp
-using Cpp_Utils::contains;
-
-// Cpp_Utils/Collection.hpp
-using Cpp_Utils::for_each;
+// Cpp_Utils/String.hpp
+using Cpp_Utils::to_string;
 
 
 namespace Game
@@ -68,22 +70,12 @@ struct Wall_Launcher_Entity_State
 };
 
 
-struct Wall_Segment
-{
-    vector<vec2> tile_positions;
-    Entity wall_launcher;
-};
-
-
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Data
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static map<Entity, Wall_Launcher_Entity_State> entity_states;
-static map<int, vector<Wall_Segment>> room_wall_segments;
-static int floor_room_tile_width;
-static int floor_room_tile_height;
 
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -91,9 +83,28 @@ static int floor_room_tile_height;
 // Utilities
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void traverse_wall(const ivec2 & origin, const function<bool(const ivec2 &)> & callback)
+static bool is_room_wall_tile(const ivec2 & tile_coordinates, int room)
 {
-    static const vector<ivec2> DIRECTIONS
+    Wall_Launcher_State & wall_state = get_world().wall_launcher;
+
+    if (tile_coordinates.x < 0 || tile_coordinates.x >= wall_state.floor_room_tile_width ||
+        tile_coordinates.y < 0 || tile_coordinates.y >= wall_state.floor_room_tile_height)
+    {
+        return false;
+    }
+
+
+    const Tile & room_tile = get_room_tile(tile_coordinates.x, tile_coordinates.y);
+
+    return room_tile.room == room && (is_wall(room_tile.type) || is_door(room_tile.type));
+}
+
+
+// Walks the wall surrounding the room origin belongs to clockwise, storing each wall tile once in room_wall_tiles in
+// traversal order.
+static void trace_room_wall(const ivec2 & origin)
+{
+    static const ivec2 DIRECTIONS[]
     {
         ivec2(0, 1),
         ivec2(1, 0),
@@ -101,149 +112,197 @@ void traverse_wall(const ivec2 & origin, const function<bool(const ivec2 &)> & c
         ivec2(-1, 0),
     };
 
-    static const vector<Tile_Types> WALL_TILE_TYPES
-    {
-        Tile_Types::DOOR,
-        Tile_Types::WALL,
-        Tile_Types::WALL_CORNER,
-        Tile_Types::WALL_CORNER_INNER,
-        Tile_Types::RIGHT_DOOR_WALL,
-        Tile_Types::LEFT_DOOR_WALL,
-    };
+    static const int DIRECTION_COUNT = sizeof(DIRECTIONS) / sizeof(ivec2);
 
+    Wall_Launcher_State & wall_state = get_world().wall_launcher;
+    const int max_wall_tile_count = wall_state.floor_room_tile_width * wall_state.floor_room_tile_height;
+    const int room = get_room_tile(origin.x, origin.y).room;
     ivec2 current_tile = origin;
     ivec2 previous_tile(-1);
     int direction_index = 0;
-    int room = get_room_tile(origin.x, origin.y).room;
+    wall_state.room_wall_tiles.clear();
 
 
     // Find clockwise traversal direction from origin tile.
-    for (size_t i = 0; i < DIRECTIONS.size(); i++)
+    for (int i = 0; i < DIRECTION_COUNT; i++)
     {
-        const ivec2 & direction = DIRECTIONS[i];
+        const ivec2 neighbor_tile = origin + DIRECTIONS[i];
 
-        if (get_room_tile(origin.x + direction.x, origin.y + direction.y).room != room)
+        if (neighbor_tile.x < 0 || neighbor_tile.x >= wall_state.floor_room_tile_width ||
+            neighbor_tile.y < 0 || neighbor_tile.y >= wall_state.floor_room_tile_height ||
+            get_room_tile(neighbor_tile.x, neighbor_tile.y).room != room)
         {
-            direction_index = wrap_index(i + 1, DIRECTIONS.size());
+            direction_index = wrap_index(i + 1, DIRECTION_COUNT);
             break;
         }
     }
 
 
-    while (callback(current_tile))
+    do
     {
-        // Find valid next tile.
+        wall_state.room_wall_tiles.push_back(current_tile);
+
+        if ((int)wall_state.room_wall_tiles.size() > max_wall_tile_count)
+        {
+            throw runtime_error("ERROR: wall of room " + to_string(room) + " does not loop back to its origin!");
+        }
+
+
+        // Find valid next tile, turning clockwise until one is found.
         ivec2 next_tile = current_tile + DIRECTIONS[direction_index];
-        const Tile * room_tile = &get_room_tile(next_tile.x, next_tile.y);
 
-        while (next_tile.x < 0 || next_tile.x >= floor_room_tile_width ||
-               next_tile.y < 0 || next_tile.y >= floor_room_tile_height ||
-               room_tile->room != room ||
-               next_tile == previous_tile ||
-               !contains(WALL_TILE_TYPES, room_tile->type))
+        for (int turns = 0;
+             next_tile == previous_tile || !is_room_wall_tile(next_tile, room);
+             turns++)
         {
-            direction_index = wrap_index(direction_index + 1, DIRECTIONS.size());
+            if (turns == DIRECTION_COUNT)
+            {
+                throw runtime_error("ERROR: wall of room " + to_string(room) + " is not connected!");
+            }
+
+            direction_index = wrap_index(direction_index + 1, DIRECTION_COUNT);
             next_tile = current_tile + DIRECTIONS[direction_index];
-            room_tile = &get_room_tile(next_tile.x, next_tile.y);
         }
 
 
         previous_tile = current_tile;
         current_tile = next_tile;
     }
+    while (current_tile != origin);
 }
 
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-//
-// Interface
-//
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void wall_launcher_init()
+// Splits room_wall_tiles into segments of contiguous non-door tiles, starting from the first door so a segment never
+// wraps around the end of the traced wall.
+static void add_room_wall_segments(int room, const vec2 & tile_scale)
 {
-    add_floor_generated_handler("wall_launcher", [&]() -> void
+    Wall_Launcher_State & wall_state = get_world().wall_launcher;
+    const int wall_tile_count = wall_state.room_wall_tiles.size();
+    int first_door_index = 0;
+
+    while (first_door_index < wall_tile_count)
     {
-        const int floor_size = get_floor_size();
-        const vec3 & room_tile_unit_size = get_room_tile_unit_size();
-        const vec2 tile_scale = vec2(room_tile_unit_size.x, room_tile_unit_size.y);
-        const int room_tile_width = get_room_tile_width();
-        const int room_tile_height = get_room_tile_height();
-        floor_room_tile_width = room_tile_width * floor_size;
-        floor_room_tile_height = room_tile_height * floor_size;
-        vector<int> processed_rooms;
-        room_wall_segments.clear();
-
-        iterate_rooms([&](int x, int y, int & room) -> void
+        const ivec2 & wall_tile = wall_state.room_wall_tiles[first_door_index];
+
+        if (is_door(get_room_tile(wall_tile.x, wall_tile.y).type))
         {
-            if (room < 1 || contains(processed_rooms, room))
-            {
-                return;
-            }
+            break;
+        }
+
+        first_door_index++;
+    }
 
-            processed_rooms.push_back(room);
-            vector<Wall_Segment> & wall_segments = room_wall_segments[room];
 
+    // A room without doors is a single segment covering its entire wall.
+    if (first_door_index == wall_tile_count)
+    {
+        first_door_index = 0;
+    }
 
-            // Find starting point for generating wall segments for room.
-            const ivec2 room_origin(x * room_tile_width, y * room_tile_height);
-            ivec2 wall_segments_origin;
 
-            traverse_wall(room_origin, [&](const ivec2 & wall_tile) -> bool
+    Wall_Segment wall_segment;
+    wall_segment.room = room;
+    wall_segment.tile_positions_begin = wall_state.wall_segment_tile_positions.size();
+    wall_segment.tile_position_count = 0;
+    wall_segment.wall_launcher = -1;
+
+    for (int i = 1; i <= wall_tile_count; i++)
+    {
+        const ivec2 & wall_tile = wall_state.room_wall_tiles[(first_door_index + i) % wall_tile_count];
+
+        if (is_door(get_room_tile(wall_tile.x, wall_tile.y).type))
+        {
+            // Adjacent doors produce no segment between them.
+            if (wall_segment.tile_position_count > 0)
             {
-                if (get_room_tile(wall_tile.x, wall_tile.y).type == Tile_Types::DOOR)
-                {
-                    wall_segments_origin = wall_tile;
-                    return false;
-                }
+                wall_state.wall_segments.push_back(wall_segment);
+            }
 
-                return true;
-            });
+            wall_segment.tile_positions_begin = wall_state.wall_segment_tile_positions.size();
+            wall_segment.tile_position_count = 0;
+            continue;
+        }
 
+        wall_state.wall_segment_tile_positions.push_back(vec2(wall_tile.x, wall_tile.y) * tile_scale);
+        wall_segment.tile_position_count++;
+    }
 
-            // Traverse wall and track contiguous segments of traversable tiles.
-            ivec2 wall_segment_start = wall_segments_origin;
+    if (wall_segment.tile_position_count > 0)
+    {
+        wall_state.wall_segments.push_back(wall_segment);
+    }
+}
 
-            do
-            {
-                Wall_Segment wall_segment;
-                wall_segment.wall_launcher = -1;
-                vector<vec2> & tile_positions = wall_segment.tile_positions;
 
-                traverse_wall(wall_segment_start, [&](const ivec2 & wall_tile) -> bool
-                {
-                    // Ignore wall segment start unless it has been reached again after looping the entire room's wall.
-                    if (wall_tile == wall_segment_start && tile_positions.size() == 0)
-                    {
-                        return true;
-                    }
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void wall_launcher_init()
+{
+    add_floor_generated_handler("wall_launcher", generate_wall_segments);
+}
 
 
-                    // Break wall segment at first traversed door.
-                    if (get_room_tile(wall_tile.x, wall_tile.y).type == Tile_Types::DOOR)
-                    {
-                        wall_segment_start = wall_tile;
-                        return false;
-                    }
+void generate_wall_segments()
+{
+    const Frame_Arena_Scope frame_arena_scope;
+    Wall_Launcher_State & wall_state = get_world().wall_launcher;
+    const int floor_size = get_floor_size();
+    const vec3 & room_tile_unit_size = get_room_tile_unit_size();
+    const vec2 tile_scale = vec2(room_tile_unit_size.x, room_tile_unit_size.y);
+    const int room_tile_width = get_room_tile_width();
+    const int room_tile_height = get_room_tile_height();
+    const int max_room_id = get_max_room_id();
+    wall_state.floor_room_tile_width = room_tile_width * floor_size;
+    wall_state.floor_room_tile_height = room_tile_height * floor_size;
+    wall_state.wall_segment_tile_positions.clear();
+    wall_state.wall_segments.clear();
+    wall_state.room_wall_segment_ranges.assign(max_room_id + 1, { 0, 0 });
+    Frame_Vector<bool> processed_rooms(max_room_id + 1, false);
+
+    iterate_rooms([&](int x, int y, int & room) -> void
+    {
+        if (room < 1 || processed_rooms[room])
+        {
+            return;
+        }
 
+        processed_rooms[room] = true;
 
-                    tile_positions.push_back(vec2(wall_tile.x, wall_tile.y) * tile_scale);
-                    return true;
-                });
 
-                wall_segments.push_back(wall_segment);
-            }
-            while (wall_segment_start != wall_segments_origin);
-        });
+        // The first cell of a room found in iteration order has no cells of the same room below or left of it, so its
+        // origin tile is always a corner of the room's wall.
+        Wall_Segment_Range & wall_segment_range = wall_state.room_wall_segment_ranges[room];
+        wall_segment_range.begin = wall_state.wall_segments.size();
+        trace_room_wall(ivec2(x * room_tile_width, y * room_tile_height));
+        add_room_wall_segments(room, tile_scale);
+        wall_segment_range.count = wall_state.wall_segments.size() - wall_segment_range.begin;
     });
 }
 
 
+void iterate_wall_segments(const function<void(int, const vec2 *, int)> & callback)
+{
+    Wall_Launcher_State & wall_state = get_world().wall_launcher;
+
+    for (const Wall_Segment & wall_segment : wall_state.wall_segments)
+    {
+        callback(
+            wall_segment.room,
+            &wall_state.wall_segment_tile_positions[wall_segment.tile_positions_begin],
+            wall_segment.tile_position_count);
+    }
+}
+
+
 void wall_launcher_subscribe(Entity entity)
 {
     entity_states[entity] =
     {
-        &((Transform *)get_component(entity, "transform"))->position,
-        &((Orientation_Handler *)get_component(entity, "orientation_handler"))->look_direction,
+        &component<Transform>(entity)->position,
+        &component<Orientation_Handler>(entity)->look_direction,
         1,
         1,
     };
@@ -252,75 +311,89 @@ void wall_launcher_subscribe(Entity entity)
 
 void wall_launcher_unsubscribe(Entity entity)
 {
+    Wall_Launcher_State & wall_state = get_world().wall_launcher;
     remove(entity_states, entity);
+
+
+    // Free the wall launcher's segment so it gets a new wall launcher if its room is built again.
+    for (Wall_Segment & wall_segment : wall_state.wall_segments)
+    {
+        if (wall_segment.wall_launcher == entity)
+        {
+            wall_segment.wall_launcher = -1;
+        }
+    }
 }
 
 
 void wall_launcher_update()
 {
+    Wall_Launcher_State & wall_state = get_world().wall_launcher;
     const float time_scale = get_time_scale();
 
 
     // Handle movement.
-    for_each(room_wall_segments, [&](int /*room*/, const vector<Wall_Segment> & wall_segments) -> void
+    for (const Wall_Segment & wall_segment : wall_state.wall_segments)
     {
-        for (const Wall_Segment & wall_segment : wall_segments)
+        if (wall_segment.wall_launcher == -1 || !contains_key(entity_states, wall_segment.wall_launcher))
         {
-            if (!contains_key(entity_states, wall_segment.wall_launcher))
-            {
-                continue;
-            }
+            continue;
+        }
 
-            Wall_Launcher_Entity_State & entity_state = entity_states[wall_segment.wall_launcher];
-            int & path_index = entity_state.path_index;
-            int & path_direction = entity_state.path_direction;
-            vec3 * position = entity_state.position;
-            vec3 * look_direction = entity_state.look_direction;
-            const vector<vec2> & tile_positions = wall_segment.tile_positions;
-            const vec2 & tile_position = tile_positions[path_index];
-            const vec2 movement = move_entity(*position, *look_direction, tile_position);
+        Wall_Launcher_Entity_State & entity_state = entity_states[wall_segment.wall_launcher];
+        int & path_index = entity_state.path_index;
+        int & path_direction = entity_state.path_direction;
+        vec3 * position = entity_state.position;
+        vec3 * look_direction = entity_state.look_direction;
+        const vec2 * tile_positions = &wall_state.wall_segment_tile_positions[wall_segment.tile_positions_begin];
+        const int tile_position_count = wall_segment.tile_position_count;
+        const vec2 & tile_position = tile_positions[path_index];
+        const vec2 movement = move_entity(*position, *look_direction, tile_position);
+        set_depth_dirty(wall_segment.wall_launcher);
 
 
-            // If game is not paused, invert look direction when traveling backwards along wall segment.
-            if (time_scale > 0)
-            {
-                *look_direction *= path_direction;
-            }
+        // If game is not paused, invert look direction when traveling backwards along wall segment.
+        if (time_scale > 0)
+        {
+            *look_direction *= path_direction;
+        }
 
 
-            if (distance(tile_position, (vec2)*position) < length(movement))
+        if (distance(tile_position, (vec2)*position) < length(movement))
+        {
+            if (path_direction == 1 && path_index == tile_position_count - 1)
             {
-                if (path_direction == 1 && path_index == tile_positions.size() - 1)
-                {
-                    path_direction = -1;
-                }
-                else if (path_direction == -1 && path_index == 0)
-                {
-                    path_direction = 1;
-                }
-
-                path_index += path_direction;
+                path_direction = -1;
             }
+            else if (path_direction == -1 && path_index == 0)
+            {
+                path_direction = 1;
+            }
+
+            path_index += path_direction;
         }
-    });
+    }
 }
 
 
-vector<Entity> wall_launcher_generate(int room, int /*room_origin_x*/, int /*room_origin_y*/)
+vector<Entity> wall_launcher_generate(int room, int /*room_origin_x*/, int /*room_origin_y*/, int /*layout*/)
 {
+    Wall_Launcher_State & wall_state = get_world().wall_launcher;
     vector<Entity> wall_launchers;
-    vector<Wall_Segment> & wall_segments = room_wall_segments[room];
+    const Wall_Segment_Range & wall_segment_range = wall_state.room_wall_segment_ranges.at(room);
 
-    for (Wall_Segment & wall_segment : wall_segments)
+    for (int i = 0; i < wall_segment_range.count; i++)
     {
+        Wall_Segment & wall_segment = wall_state.wall_segments[wall_segment_range.begin + i];
         Entity & wall_launcher = wall_segment.wall_launcher;
 
         if (wall_launcher == -1)
         {
             wall_launcher = load_blueprint("wall_launcher");
             wall_launchers.push_back(wall_launcher);
-            const vec2 & segment_start_tile_position = wall_segment.tile_positions[0];
-            vec3 & wall_launcher_position = ((Transform *)get_component(wall_launcher, "transform"))->position;
+            const vec2 & segment_start_tile_position =
+                wall_state.wall_segment_tile_positions[wall_segment.tile_positions_begin];
+            vec3 & wall_launcher_position = component<Transform>(wall_launcher)->position;
             wall_launcher_position.x = segment_start_tile_position.x;
             wall_launcher_position.y = segment_start_tile_position.y;
         }
@@ -7,14 +7,16 @@
 #include "Nito/Components.hpp"
 #include "Nito/Collider_Component.hpp"
 #include "Nito/Engine.hpp"
-#include "Nito/APIs/Scene.hpp"
 #include "Nito/APIs/Window.hpp"
 #include "Cpp_Utils/Vector.hpp"
 
+#include "Game/Component_Types.hpp"
 #include "Game/Components.hpp"
+#include "Game/World.hpp"
 
 
 using std::isnan;
+using std::nextafter;
 using std::string;
 using std::vector;
 
@@ -39,11 +41,6 @@ using Nito::get_time_scale;
 
 // Nito/APIs/ECS.hpp
 using Nito::Entity;
-using Nito::has_component;
-using Nito::get_component;
-
-// Nito/APIs/Scene.hpp
-using Nito::load_blueprint;
 
 // Nito/APIs/Window.hpp
 using Nito::get_delta_time;
@@ -61,41 +58,46 @@ namespace Game
 // Interface
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-void fire_projectile(
-    const string & name,
-    const vec3 & origin,
-    const vec3 & direction,
-    float duration,
-    const vector<string> & target_layers,
-    float damage_modifier)
+int random(int min, int max)
 {
-    Entity projectile_entity = load_blueprint(name);
-    auto projectile = (Projectile *)get_component(projectile_entity, "projectile");
-    ((Transform *)get_component(projectile_entity, "transform"))->position = origin;
-    projectile->direction = normalize(vec3(direction.x, direction.y, 0));
-    projectile->duration = duration;
-    projectile->target_layers = target_layers;
-    projectile->damage *= damage_modifier;
+    World & world = get_world();
+
+    if (!world.random_seeded)
+    {
+        seed_random(time(NULL));
+    }
+
+    return min == max ? min : (world.random_engine() % (max - min)) + min;
 }
 
 
-int random(int min, int max)
+// Returns a value in [min, max). The highest engine values round to max as floats, so they're clamped back below it.
+float random(float min, float max)
 {
-    static bool srand_set = false;
+    World & world = get_world();
 
-    if (!srand_set)
+    if (!world.random_seeded)
     {
-        srand(time(NULL));
-        srand_set = true;
+        seed_random(time(NULL));
     }
 
-    return min == max ? min : (rand() % (max - min)) + min;
+    const double unit = world.random_engine() / ((double)world.random_engine.max() + 1.0);
+    const float value = (float)(min + ((max - (double)min) * unit));
+    return value < max || min == max ? value : nextafter(max, min);
+}
+
+
+void seed_random(unsigned int seed)
+{
+    World & world = get_world();
+    world.random_engine.seed(seed);
+    world.random_seeded = true;
 }
 
 
 bool in_layer(Entity entity, const string & layer)
 {
-    return has_component(entity, "layers") && contains(*(vector<string> *)get_component(entity, "layers"), layer);
+    return has<Layers>(entity) && contains(*component<Layers>(entity), layer);
 }
 
 
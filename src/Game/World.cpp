@@ -0,0 +1,36 @@
+#include "Game/World.hpp"
+
+
+namespace Game
+{
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The game's own world, which threads simulate until they are given one of their own.
+static World game_world;
+
+static thread_local World * current_world = &game_world;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Interface
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+World & get_world()
+{
+    return *current_world;
+}
+
+
+void set_world(World & world)
+{
+    current_world = &world;
+}
+
+
+} // namespace Game
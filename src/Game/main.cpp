@@ -4,7 +4,6 @@
 #include <string>
 #include <vector>
 #include <map>
-#include <glm/glm.hpp>
 #include "Nito/Engine.hpp"
 #include "Nito/APIs/ECS.hpp"
 #include "Cpp_Utils/Collection.hpp"
@@ -12,6 +11,13 @@
 
 #include "Game/Components.hpp"
 #include "Game/APIs/Audio_Manager.hpp"
+#include "Game/APIs/Bullet_Patterns.hpp"
+#include "Game/APIs/Drop_Table.hpp"
+#include "Game/APIs/Data_Reloader.hpp"
+#include "Game/APIs/Update_Profiler.hpp"
+#include "Game/APIs/Allocation_Tracker.hpp"
+#include "Game/APIs/Frame_Arena.hpp"
+#include "Game/APIs/Timer_Wheel.hpp"
 #include "Game/Systems/Player_Controller.hpp"
 #include "Game/Systems/Projectile.hpp"
 #include "Game/Systems/Depth_Handler.hpp"
@@ -31,23 +37,20 @@
 #include "Game/Systems/Floor_Entity.hpp"
 #include "Game/Systems/Enemy.hpp"
 #include "Game/Systems/Boss.hpp"
-#include "Game/Systems/Boss_Segment.hpp"
 #include "Game/Systems/Wall_Launcher.hpp"
 #include "Game/Systems/Enemy_Projectile_Launcher.hpp"
 #include "Game/Systems/Tile_Turret.hpp"
 #include "Game/Systems/Reticle.hpp"
 #include "Game/Systems/Item.hpp"
 #include "Game/Systems/Health_Item.hpp"
+#include "Game/Systems/Light_Handler.hpp"
+#include "Game/Systems/Stress_Benchmark.hpp"
 
 
 using std::string;
 using std::vector;
 using std::map;
 
-// glm/glm.hpp
-using glm::vec3;
-using glm::vec2;
-
 // Nito/Engine.hpp
 using Nito::add_update_handler;
 using Nito::run_engine;
@@ -67,33 +70,86 @@ using Cpp_Utils::for_each;
 
 // Cpp_Utils/JSON.hpp
 using Cpp_Utils::JSON;
-using Cpp_Utils::contains_key;
 
 
 namespace Game
 {
 
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename T>
+static Component_Handlers get_descriptor_component_handlers()
+{
+    return
+    {
+        [](const JSON & data) -> Component
+        {
+            return parse_component<T>(data);
+        },
+        get_component_deallocator<T>(),
+    };
+}
+
+
+// Records how many components of a type are alive and how much memory they hold. Both building and destroying a
+// component record the net bytes they left allocated, so temporaries either makes don't build up in the footprint.
+static Component_Handlers get_tracked_component_handlers(
+    const string & type,
+    const Component_Handlers & component_handlers)
+{
+    const auto allocator = component_handlers.allocator;
+    const auto deallocator = component_handlers.deallocator;
+
+    return
+    {
+        [=](const JSON & data) -> Component
+        {
+            const long long start_live_bytes = get_live_allocated_bytes();
+            const Component component = allocator(data);
+            track_component_footprint(type, 1, get_live_allocated_bytes() - start_live_bytes);
+            return component;
+        },
+        [=](Component component) -> void
+        {
+            const long long start_live_bytes = get_live_allocated_bytes();
+            deallocator(component);
+            track_component_footprint(type, -1, get_live_allocated_bytes() - start_live_bytes);
+        },
+    };
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 // Data
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Game update handlers are profiled so the stress benchmark can time each of them, apart from the frame arena reset,
+// the data reloader and the benchmark itself.
 static const vector<Update_Handler> GAME_UPDATE_HANDLERS
 {
-    player_controller_update,
-    projectile_update,
-    depth_handler_update,
-    turret_update,
-    orientation_handler_update,
-    health_bar_update,
-    camera_controller_update,
-    boss_update,
-    boss_segment_update,
-    wall_launcher_update,
-    enemy_projectile_launcher_update,
-    tile_turret_update,
-    reticle_update,
+    frame_arena_update,
+    data_reloader_update,
+    stress_benchmark_update,
+    GAME_PROFILED_UPDATE_HANDLER(timer_wheel_update),
+    GAME_PROFILED_UPDATE_HANDLER(player_controller_update),
+    GAME_PROFILED_UPDATE_HANDLER(projectile_update),
+    GAME_PROFILED_UPDATE_HANDLER(depth_handler_update),
+    GAME_PROFILED_UPDATE_HANDLER(turret_update),
+    GAME_PROFILED_UPDATE_HANDLER(orientation_handler_update),
+    GAME_PROFILED_UPDATE_HANDLER(health_bar_update),
+    GAME_PROFILED_UPDATE_HANDLER(camera_controller_update),
+    GAME_PROFILED_UPDATE_HANDLER(boss_update),
+    GAME_PROFILED_UPDATE_HANDLER(wall_launcher_update),
+    GAME_PROFILED_UPDATE_HANDLER(enemy_projectile_launcher_update),
+    GAME_PROFILED_UPDATE_HANDLER(tile_turret_update),
+    GAME_PROFILED_UPDATE_HANDLER(reticle_update),
+    GAME_PROFILED_UPDATE_HANDLER(audio_manager_update),
+    GAME_PROFILED_UPDATE_HANDLER(light_handler_update),
 };
 
 
@@ -118,94 +174,26 @@ static const map<string, const System_Entity_Handlers> GAME_SYSTEM_ENTITY_HANDLE
     NITO_SYSTEM_ENTITY_HANDLERS(floor_entity),
     NITO_SYSTEM_ENTITY_HANDLERS(enemy),
     NITO_SYSTEM_ENTITY_HANDLERS(boss),
-    NITO_SYSTEM_ENTITY_HANDLERS(boss_segment),
     NITO_SYSTEM_ENTITY_HANDLERS(wall_launcher),
     NITO_SYSTEM_ENTITY_HANDLERS(enemy_projectile_launcher),
     NITO_SYSTEM_ENTITY_HANDLERS(tile_turret),
     NITO_SYSTEM_ENTITY_HANDLERS(reticle),
     NITO_SYSTEM_ENTITY_HANDLERS(item),
     NITO_SYSTEM_ENTITY_HANDLERS(health_item),
+    NITO_SYSTEM_ENTITY_HANDLERS(light_handler),
+    NITO_SYSTEM_ENTITY_HANDLERS(stress_benchmark),
 };
 
 
 static const map<string, const Component_Handlers> GAME_COMPONENT_HANDLERS
 {
-    {
-        "player_controller",
-        {
-            [](const JSON & data) -> Component
-            {
-                static const map<string, const Player_Controller::Modes> MODES
-                {
-                    { "controller"     , Player_Controller::Modes::CONTROLLER     },
-                    { "keyboard_mouse" , Player_Controller::Modes::KEYBOARD_MOUSE },
-                };
-
-                return new Player_Controller
-                {
-                    data["speed"],
-                    data["stick_dead_zone"],
-                    MODES.at(data["mode"]),
-                };
-            },
-            get_component_deallocator<Player_Controller>(),
-        }
-    },
-    {
-        "projectile",
-        {
-            [](const JSON & data) -> Component
-            {
-                auto projectile = new Projectile;
-                projectile->speed = contains_key(data, "speed") ? data["speed"].get<float>() : 1.0f;
-                projectile->duration = contains_key(data, "duration") ? data["duration"].get<float>() : 1.0f;
-                projectile->damage = contains_key(data, "damage") ? data["damage"].get<float>() : 10.0f;
-                vec3 & direction = projectile->direction;
-
-                if (contains_key(data, "direction"))
-                {
-                    const JSON & direction_data = data["direction"];
-                    direction.x = direction_data["x"];
-                    direction.y = direction_data["y"];
-                }
-
-                if (contains_key(data, "target_layers"))
-                {
-                    projectile->target_layers = data["target_layers"].get<vector<string>>();
-                }
-
-                if (contains_key(data, "ignore_layers"))
-                {
-                    projectile->ignore_layers = data["ignore_layers"].get<vector<string>>();
-                }
-
-                return projectile;
-            },
-            get_component_deallocator<Projectile>(),
-        }
-    },
-    {
-        "orientation_handler",
-        {
-            [](const JSON & data) -> Component
-            {
-                const JSON & orientation_texture_paths = data["texture_paths"];
-
-                return new Orientation_Handler
-                {
-                    Orientation::DOWN,
-                    vec3(0.0f, -1.0f, 0.0f),
-                    {
-                        { Orientation::UP    , orientation_texture_paths["up"].get<string>()    },
-                        { Orientation::DOWN  , orientation_texture_paths["down"].get<string>()  },
-                        { Orientation::LEFT  , orientation_texture_paths["left"].get<string>()  },
-                        { Orientation::RIGHT , orientation_texture_paths["right"].get<string>() },
-                    },
-                };
-            },
-            get_component_deallocator<Orientation_Handler>(),
-        }
-    },
+    { "player_controller"         , get_descriptor_component_handlers<Player_Controller>()         },
+    { "projectile"                , get_descriptor_component_handlers<Projectile>()                },
+    { "orientation_handler"       , get_descriptor_component_handlers<Orientation_Handler>()       },
+    { "room_exit"                 , get_descriptor_component_handlers<Room_Exit>()                 },
+    { "menu_buttons_handler"      , get_descriptor_component_handlers<Menu_Buttons_Handler>()      },
+    { "enemy_projectile_launcher" , get_descriptor_component_handlers<Enemy_Projectile_Launcher>() },
+    { "health_item"               , get_descriptor_component_handlers<Health_Item>()               },
     {
         "health",
         {
@@ -222,66 +210,27 @@ static const map<string, const Component_Handlers> GAME_COMPONENT_HANDLERS
         }
     },
     {
-        "layers",
-        {
-            get_component_allocator<vector<string>>(),
-            get_component_deallocator<vector<string>>(),
-        }
-    },
-    {
-        "target_id",
-        {
-            get_component_allocator<string>(),
-            get_component_deallocator<string>(),
-        }
-    },
-    {
-        "room_exit",
+        "item",
         {
-            [](const JSON & data) -> Component
+            [](const JSON & /*data*/) -> Component
             {
-                static const map<string, Room_Exit::Types> ROOM_EXIT_TYPES
-                {
-                    { "door"       , Room_Exit::Types::DOOR       },
-                    { "next_floor" , Room_Exit::Types::NEXT_FLOOR },
-                };
-
-                return new Room_Exit
-                {
-                    ROOM_EXIT_TYPES.at(data["type"]),
-                    false,
-                    data["locked_texture_path"],
-                };
+                return new Item;
             },
-            get_component_deallocator<Room_Exit>(),
+            get_component_deallocator<Item>(),
         }
     },
     {
-        "menu_buttons_handler",
+        "layers",
         {
-            [](const JSON & data) -> Component
-            {
-                auto menu_buttons_handler = new Menu_Buttons_Handler;
-                vector<string> & button_names = menu_buttons_handler->button_names;
-
-                for (const string & button_name : data["button_names"])
-                {
-                    button_names.push_back(button_name);
-                }
-
-                return menu_buttons_handler;
-            },
-            get_component_deallocator<Menu_Buttons_Handler>(),
+            get_component_allocator<vector<string>>(),
+            get_component_deallocator<vector<string>>(),
         }
     },
     {
-        "destination",
+        "target_id",
         {
-            [](const JSON & /*data*/) -> Component
-            {
-                return new vec2;
-            },
-            get_component_deallocator<vec2>(),
+            get_component_allocator<string>(),
+            get_component_deallocator<string>(),
         }
     },
     {
@@ -291,62 +240,6 @@ static const map<string, const Component_Handlers> GAME_COMPONENT_HANDLERS
             get_component_deallocator<bool>(),
         }
     },
-    {
-        "enemy_projectile_launcher",
-        {
-            [](const JSON & data) -> Component
-            {
-                const JSON & orientation_offsets_data = data["orientation_offsets"];
-                const JSON & left_orientation_offset_data = orientation_offsets_data["left"];
-                const JSON & right_orientation_offset_data = orientation_offsets_data["right"];
-                const JSON & down_orientation_offset_data = orientation_offsets_data["down"];
-                const JSON & up_orientation_offset_data = orientation_offsets_data["up"];
-                auto enemy_projectile_launcher = new Enemy_Projectile_Launcher;
-                enemy_projectile_launcher->enabled = contains_key(data, "enabled") ? data["enabled"].get<bool>() : true;
-                enemy_projectile_launcher->cooldown_time = data["cooldown_time"];
-                enemy_projectile_launcher->range = data["range"];
-                enemy_projectile_launcher->projectile_name = data["projectile_name"];
-                map<Orientation, vec3> & orientation_offsets = enemy_projectile_launcher->orientation_offsets;
-                vec3 & left_orientation_offset = orientation_offsets[Orientation::LEFT];
-                vec3 & right_orientation_offset = orientation_offsets[Orientation::RIGHT];
-                vec3 & down_orientation_offset = orientation_offsets[Orientation::DOWN];
-                vec3 & up_orientation_offset = orientation_offsets[Orientation::UP];
-                left_orientation_offset.x = left_orientation_offset_data["x"];
-                left_orientation_offset.y = left_orientation_offset_data["y"];
-                right_orientation_offset.x = right_orientation_offset_data["x"];
-                right_orientation_offset.y = right_orientation_offset_data["y"];
-                down_orientation_offset.x = down_orientation_offset_data["x"];
-                down_orientation_offset.y = down_orientation_offset_data["y"];
-                up_orientation_offset.x = up_orientation_offset_data["x"];
-                up_orientation_offset.y = up_orientation_offset_data["y"];
-                return enemy_projectile_launcher;
-            },
-            get_component_deallocator<Enemy_Projectile_Launcher>(),
-        }
-    },
-    {
-        "item",
-        {
-            [](const JSON & /*data*/) -> Component
-            {
-                return new Item;
-            },
-            get_component_deallocator<Item>(),
-        }
-    },
-    {
-        "health_item",
-        {
-            [](const JSON & data) -> Component
-            {
-                return new Health_Item
-                {
-                    data["health_restored"],
-                };
-            },
-            get_component_deallocator<Health_Item>(),
-        }
-    },
 };
 
 
@@ -368,15 +261,26 @@ int run()
 
     for_each(GAME_COMPONENT_HANDLERS, [](const string & type, const Component_Handlers & component_handlers) -> void
     {
-        set_component_handlers(type, component_handlers.allocator, component_handlers.deallocator);
+        const Component_Handlers & registered_component_handlers =
+            is_allocation_tracking()
+            ? get_tracked_component_handlers(type, component_handlers)
+            : component_handlers;
+
+        set_component_handlers(
+            type,
+            registered_component_handlers.allocator,
+            registered_component_handlers.deallocator);
     });
 
+    data_reloader_api_init();
     audio_manager_api_init();
     turret_init();
-    tile_turret_init();
     wall_launcher_init();
-    item_init();
-    return run_engine();
+    drop_table_api_init();
+    bullet_patterns_api_init();
+    const int exit_code = run_engine();
+    data_reloader_api_shutdown();
+    return exit_code;
 }
 
 
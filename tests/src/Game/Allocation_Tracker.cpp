@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "Game/APIs/Allocation_Tracker.hpp"
+
+
+using std::string;
+
+// Game/APIs/Allocation_Tracker.hpp
+using Game::Allocation_Counts;
+using Game::Component_Footprint;
+using Game::is_allocation_tracking;
+using Game::get_allocation_counts;
+using Game::get_live_allocated_bytes;
+using Game::track_component_footprint;
+using Game::iterate_component_footprints;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static Component_Footprint get_component_footprint(const string & type)
+{
+    Component_Footprint found_component_footprint { type, 0, 0 };
+
+    iterate_component_footprints([&](const Component_Footprint & component_footprint) -> void
+    {
+        if (component_footprint.type == type)
+        {
+            found_component_footprint = component_footprint;
+        }
+    });
+
+    return found_component_footprint;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Tests
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Counts stay 0 unless the tests are built with GAME_ALLOCATION_TRACKING defined.
+TEST(Allocation_Tracker, CountsAllocationsAndDeallocations)
+{
+    const long long expected_count = is_allocation_tracking() ? 1 : 0;
+    const long long expected_bytes = expected_count * (long long)sizeof(double);
+    const Allocation_Counts start_allocation_counts = get_allocation_counts();
+
+
+    // Stored through a volatile pointer so the compiler can't elide the allocation.
+    double * volatile value = new double(1.0);
+    const Allocation_Counts allocated_allocation_counts = get_allocation_counts();
+    delete value;
+    const Allocation_Counts end_allocation_counts = get_allocation_counts();
+
+    EXPECT_EQ(
+        allocated_allocation_counts.allocation_count - start_allocation_counts.allocation_count,
+        expected_count);
+
+    EXPECT_EQ(allocated_allocation_counts.allocated_bytes - start_allocation_counts.allocated_bytes, expected_bytes);
+    EXPECT_EQ(allocated_allocation_counts.deallocation_count, start_allocation_counts.deallocation_count);
+
+    EXPECT_EQ(
+        end_allocation_counts.deallocation_count - allocated_allocation_counts.deallocation_count,
+        expected_count);
+
+    EXPECT_EQ(end_allocation_counts.deallocated_bytes - allocated_allocation_counts.deallocated_bytes, expected_bytes);
+    EXPECT_EQ(end_allocation_counts.allocation_count, allocated_allocation_counts.allocation_count);
+}
+
+
+// Mirrors how component handlers are tracked: building and destroying each record the net bytes they left allocated,
+// so a component whose destruction allocates temporaries still returns its footprint to 0.
+TEST(Allocation_Tracker, ComponentFootprintsReturnToZero)
+{
+    static const string TYPE("allocation_tracker_test_component");
+    long long start_live_bytes = get_live_allocated_bytes();
+    string * volatile component = new string(256, 'x');
+    track_component_footprint(TYPE, 1, get_live_allocated_bytes() - start_live_bytes);
+    const Component_Footprint built_component_footprint = get_component_footprint(TYPE);
+    EXPECT_EQ(built_component_footprint.live_count, 1);
+
+    if (is_allocation_tracking())
+    {
+        EXPECT_GE(built_component_footprint.live_bytes, 256 + (long long)sizeof(string));
+    }
+
+    start_live_bytes = get_live_allocated_bytes();
+    string * volatile temporary = new string(*component + *component);
+    delete component;
+    delete temporary;
+    track_component_footprint(TYPE, -1, get_live_allocated_bytes() - start_live_bytes);
+    const Component_Footprint destroyed_component_footprint = get_component_footprint(TYPE);
+    EXPECT_EQ(destroyed_component_footprint.live_count, 0);
+    EXPECT_EQ(destroyed_component_footprint.live_bytes, 0);
+}
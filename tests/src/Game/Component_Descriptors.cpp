@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <glm/glm.hpp>
+#include "Cpp_Utils/JSON.hpp"
+
+#include "Game/Components.hpp"
+
+
+using std::map;
+using std::unique_ptr;
+using std::string;
+using std::vector;
+using std::uint32_t;
+using std::memset;
+using std::runtime_error;
+
+// glm/glm.hpp
+using glm::vec3;
+
+// Cpp_Utils/JSON.hpp
+using Cpp_Utils::JSON;
+
+// Game/Components.hpp
+using Game::Orientation;
+using Game::Player_Controller;
+using Game::Projectile;
+using Game::Orientation_Handler;
+using Game::Room_Exit;
+using Game::Enemy_Projectile_Launcher;
+
+// Game/Component_Descriptors.hpp
+using Game::parse_component;
+using Game::serialize_component;
+using Game::deserialize_component;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const JSON ENEMY_PROJECTILE_LAUNCHER_DATA = JSON::parse(R"(
+{
+    "range": 4.5,
+    "bullet_pattern": "enemy_orb",
+    "orientation_offsets":
+    {
+        "left": { "x": -0.5, "y": 0.25 },
+        "down": { "y": -0.5 }
+    }
+}
+)");
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename Component>
+static Component * deserialize(const vector<char> & buffer)
+{
+    const char * bytes = buffer.data();
+    Component * component = deserialize_component<Component>(bytes, buffer.data() + buffer.size());
+    EXPECT_EQ(bytes, buffer.data() + buffer.size());
+    return component;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Parsing
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST(Component_Descriptors, ParsesFieldsAndEnums)
+{
+    const unique_ptr<Player_Controller> player_controller(parse_component<Player_Controller>(JSON::parse(R"(
+    {
+        "speed": 2.5,
+        "stick_dead_zone": 0.2,
+        "mode": "bot",
+        "unknown_field": true
+    }
+    )")));
+
+    EXPECT_FLOAT_EQ(player_controller->speed, 2.5f);
+    EXPECT_FLOAT_EQ(player_controller->stick_dead_zone, 0.2f);
+    EXPECT_EQ(player_controller->mode, Player_Controller::Modes::BOT);
+}
+
+
+TEST(Component_Descriptors, OptionalFieldsKeepDefaults)
+{
+    const unique_ptr<Projectile> projectile(parse_component<Projectile>(JSON::parse(R"({ "damage": 25 })")));
+    EXPECT_FLOAT_EQ(projectile->damage, 25.0f);
+    EXPECT_FLOAT_EQ(projectile->speed, 1.0f);
+    EXPECT_FLOAT_EQ(projectile->duration, 1.0f);
+    EXPECT_TRUE(projectile->ignore_layers.empty());
+}
+
+
+TEST(Component_Descriptors, ParsesEnumKeyedMaps)
+{
+    const unique_ptr<Enemy_Projectile_Launcher> enemy_projectile_launcher(
+        parse_component<Enemy_Projectile_Launcher>(ENEMY_PROJECTILE_LAUNCHER_DATA));
+
+    const map<Orientation, vec3> & orientation_offsets = enemy_projectile_launcher->orientation_offsets;
+    EXPECT_TRUE(enemy_projectile_launcher->enabled);
+    EXPECT_FLOAT_EQ(enemy_projectile_launcher->range, 4.5f);
+    EXPECT_EQ(enemy_projectile_launcher->bullet_pattern, "enemy_orb");
+    ASSERT_EQ(orientation_offsets.size(), 2u);
+    EXPECT_EQ(orientation_offsets.at(Orientation::LEFT), vec3(-0.5f, 0.25f, 0.0f));
+    EXPECT_EQ(orientation_offsets.at(Orientation::DOWN), vec3(0.0f, -0.5f, 0.0f));
+}
+
+
+TEST(Component_Descriptors, RejectsMissingRequiredFields)
+{
+    EXPECT_THROW(parse_component<Room_Exit>(JSON::parse(R"({ "type": "door" })")), runtime_error);
+}
+
+
+TEST(Component_Descriptors, RejectsInvalidEnumNames)
+{
+    EXPECT_THROW(
+        parse_component<Room_Exit>(JSON::parse(R"({ "type": "window", "locked_texture_path": "" })")),
+        runtime_error);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Binary Round Trips
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST(Component_Descriptors, RoundTripsThroughBinary)
+{
+    const unique_ptr<Enemy_Projectile_Launcher> enemy_projectile_launcher(
+        parse_component<Enemy_Projectile_Launcher>(ENEMY_PROJECTILE_LAUNCHER_DATA));
+
+    vector<char> buffer;
+    serialize_component(*enemy_projectile_launcher, buffer);
+
+    const unique_ptr<Enemy_Projectile_Launcher> deserialized_enemy_projectile_launcher(
+        deserialize<Enemy_Projectile_Launcher>(buffer));
+
+    EXPECT_EQ(deserialized_enemy_projectile_launcher->enabled, enemy_projectile_launcher->enabled);
+    EXPECT_EQ(deserialized_enemy_projectile_launcher->range, enemy_projectile_launcher->range);
+    EXPECT_EQ(deserialized_enemy_projectile_launcher->bullet_pattern, enemy_projectile_launcher->bullet_pattern);
+
+    EXPECT_EQ(
+        deserialized_enemy_projectile_launcher->orientation_offsets,
+        enemy_projectile_launcher->orientation_offsets);
+
+
+    // Projectiles cover vectors of strings and vec3s.
+    Projectile projectile;
+    projectile.direction = vec3(1.0f, 2.0f, 3.0f);
+    projectile.ignore_layers = { "wall", "", "enemy" };
+    buffer.clear();
+    serialize_component(projectile, buffer);
+    const unique_ptr<Projectile> deserialized_projectile(deserialize<Projectile>(buffer));
+    EXPECT_EQ(deserialized_projectile->direction, projectile.direction);
+    EXPECT_EQ(deserialized_projectile->ignore_layers, projectile.ignore_layers);
+}
+
+
+TEST(Component_Descriptors, RejectsTruncatedBinary)
+{
+    Orientation_Handler orientation_handler;
+    orientation_handler.orientation_texture_paths[Orientation::UP] = "resources/textures/up.png";
+    orientation_handler.orientation_texture_paths[Orientation::DOWN] = "resources/textures/down.png";
+    vector<char> buffer;
+    serialize_component(orientation_handler, buffer);
+
+
+    // Every strict prefix of the data ends partway through a field.
+    for (size_t size = 0; size < buffer.size(); size++)
+    {
+        const char * bytes = buffer.data();
+
+        EXPECT_THROW(
+            delete deserialize_component<Orientation_Handler>(bytes, buffer.data() + size),
+            runtime_error) << "size " << size;
+    }
+}
+
+
+TEST(Component_Descriptors, RejectsCountsLargerThanTheData)
+{
+    Projectile projectile;
+    vector<char> buffer;
+    serialize_component(projectile, buffer);
+
+
+    // The ignore layers count is the last field, and claims far more strings than the data holds.
+    memset(&buffer[buffer.size() - sizeof(uint32_t)], 0xFF, sizeof(uint32_t));
+    const char * bytes = buffer.data();
+    EXPECT_THROW(delete deserialize_component<Projectile>(bytes, buffer.data() + buffer.size()), runtime_error);
+}
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <functional>
+
+#include "Game/APIs/Frame_Arena.hpp"
+
+
+using std::size_t;
+using std::uintptr_t;
+using std::max_align_t;
+using std::memset;
+using std::thread;
+using std::function;
+
+// Game/APIs/Frame_Arena.hpp
+using Game::Frame_Arena_Mark;
+using Game::Frame_Arena_Scope;
+using Game::Frame_Vector;
+using Game::frame_arena_update;
+using Game::allocate_frame_memory;
+using Game::get_frame_arena_mark;
+using Game::get_frame_arena_capacity;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Each thread has its own frame arena, so running a test on a new thread starts it with an empty arena regardless of
+// what other tests left in the main thread's.
+static void run_with_empty_frame_arena(const function<void()> & test)
+{
+    thread(test).join();
+}
+
+
+static bool is_aligned(const void * memory, size_t alignment)
+{
+    return (uintptr_t)memory % alignment == 0;
+}
+
+
+// The arena's first block is a standard block, as long as the first allocation fits in one.
+static size_t get_frame_arena_block_size()
+{
+    allocate_frame_memory(1, 1);
+    const size_t block_size = get_frame_arena_capacity();
+    frame_arena_update();
+    return block_size;
+}
+
+
+static bool operator==(const Frame_Arena_Mark & a, const Frame_Arena_Mark & b)
+{
+    return a.block == b.block && a.offset == b.offset;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Tests
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST(Frame_Arena, AlignsMixedTypeAllocations)
+{
+    run_with_empty_frame_arena([]() -> void
+    {
+        static const size_t ALIGNMENTS[] { 1, 8, 2, alignof(max_align_t), 1, 4, 8, 1, alignof(max_align_t) };
+        const char * previous_end = nullptr;
+
+        for (const size_t alignment : ALIGNMENTS)
+        {
+            char * memory = (char *)allocate_frame_memory(3, alignment);
+            EXPECT_TRUE(is_aligned(memory, alignment)) << "alignment " << alignment;
+            EXPECT_TRUE(previous_end == nullptr || memory >= previous_end) << "alignment " << alignment;
+            previous_end = memory + 3;
+        }
+
+        Frame_Vector<char> chars(5, 'a');
+        Frame_Vector<double> doubles(3, 1.0);
+        Frame_Vector<long long> long_longs(2, 1);
+        EXPECT_TRUE(is_aligned(doubles.data(), alignof(double)));
+        EXPECT_TRUE(is_aligned(long_longs.data(), alignof(long long)));
+    });
+}
+
+
+TEST(Frame_Arena, FitsAllocationsLargerThanABlock)
+{
+    run_with_empty_frame_arena([]() -> void
+    {
+        const size_t block_size = get_frame_arena_block_size();
+        const size_t large_size = (block_size * 3) + 1;
+        char * small_memory = (char *)allocate_frame_memory(16, 1);
+        char * large_memory = (char *)allocate_frame_memory(large_size, alignof(max_align_t));
+        ASSERT_NE(large_memory, nullptr);
+        EXPECT_TRUE(is_aligned(large_memory, alignof(max_align_t)));
+        EXPECT_GE(get_frame_arena_capacity(), block_size + large_size);
+
+
+        // The whole allocation must be writable without touching the memory around it.
+        memset(small_memory, 1, 16);
+        memset(large_memory, 2, large_size);
+        char * next_memory = (char *)allocate_frame_memory(16, 1);
+        memset(next_memory, 3, 16);
+        EXPECT_EQ(small_memory[15], 1);
+        EXPECT_EQ(large_memory[0], 2);
+        EXPECT_EQ(large_memory[large_size - 1], 2);
+    });
+}
+
+
+TEST(Frame_Arena, ReusesBlocksAfterUpdate)
+{
+    run_with_empty_frame_arena([]() -> void
+    {
+        const size_t block_size = get_frame_arena_block_size();
+        const size_t allocation_size = (block_size / 2) + 1;
+        void * first_frame_memory[4];
+        void * second_frame_memory[4];
+
+
+        // Each allocation is over half a block, so every one of them takes a block of its own.
+        for (void * & memory : first_frame_memory)
+        {
+            memory = allocate_frame_memory(allocation_size, 1);
+        }
+
+        const size_t capacity = get_frame_arena_capacity();
+        EXPECT_EQ(capacity, block_size * 4);
+        frame_arena_update();
+
+        for (void * & memory : second_frame_memory)
+        {
+            memory = allocate_frame_memory(allocation_size, 1);
+        }
+
+        EXPECT_EQ(get_frame_arena_capacity(), capacity);
+
+        for (int i = 0; i < 4; i++)
+        {
+            EXPECT_EQ(second_frame_memory[i], first_frame_memory[i]) << "allocation " << i;
+        }
+    });
+}
+
+
+TEST(Frame_Arena, NestedScopesRewindToTheirOwnMarks)
+{
+    run_with_empty_frame_arena([]() -> void
+    {
+        const size_t block_size = get_frame_arena_block_size();
+        allocate_frame_memory(8, 1);
+        const Frame_Arena_Mark outer_mark = get_frame_arena_mark();
+        void * inner_memory;
+
+        {
+            const Frame_Arena_Scope outer_scope;
+            inner_memory = allocate_frame_memory(32, 8);
+            const Frame_Arena_Mark inner_mark = get_frame_arena_mark();
+
+            {
+                const Frame_Arena_Scope inner_scope;
+                allocate_frame_memory(64, 8);
+
+
+                // Spill into another block, which rewinding must also back out of.
+                allocate_frame_memory(block_size, 1);
+                EXPECT_FALSE(get_frame_arena_mark() == inner_mark);
+            }
+
+            EXPECT_TRUE(get_frame_arena_mark() == inner_mark);
+        }
+
+        EXPECT_TRUE(get_frame_arena_mark() == outer_mark);
+        EXPECT_EQ(allocate_frame_memory(32, 8), inner_memory);
+    });
+}
+
+
+TEST(Frame_Arena, ThreadsHaveSeparateArenas)
+{
+    run_with_empty_frame_arena([]() -> void
+    {
+        char * memory = (char *)allocate_frame_memory(64, 1);
+        memset(memory, 1, 64);
+        const Frame_Arena_Mark mark = get_frame_arena_mark();
+        const size_t capacity = get_frame_arena_capacity();
+
+        run_with_empty_frame_arena([]() -> void
+        {
+            EXPECT_EQ(get_frame_arena_capacity(), 0u);
+            memset(allocate_frame_memory(64, 1), 2, 64);
+            frame_arena_update();
+            EXPECT_EQ(get_frame_arena_mark().offset, 0u);
+        });
+
+
+        // Neither the other thread's allocation nor its reset touched this thread's arena.
+        EXPECT_TRUE(get_frame_arena_mark() == mark);
+        EXPECT_EQ(get_frame_arena_capacity(), capacity);
+
+        for (int i = 0; i < 64; i++)
+        {
+            EXPECT_EQ(memory[i], 1) << "byte " << i;
+        }
+    });
+}
@@ -0,0 +1,991 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <functional>
+#include <stdexcept>
+#include <glm/glm.hpp>
+#include "Cpp_Utils/JSON.hpp"
+#include "Cpp_Utils/Vector.hpp"
+#include "Cpp_Utils/Map.hpp"
+
+#include "Game/APIs/Floor_Manager.hpp"
+#include "Game/APIs/Floor_Snapshot.hpp"
+#include "Game/APIs/Enemy_Manager.hpp"
+#include "Game/APIs/Minimap.hpp"
+#include "Game/APIs/Allocation_Tracker.hpp"
+#include "Game/Systems/Wall_Launcher.hpp"
+#include "Game/Systems/Turret.hpp"
+#include "Game/Utilities.hpp"
+#include "Game/World.hpp"
+
+
+using std::string;
+using std::vector;
+using std::map;
+using std::sort;
+using std::find;
+using std::function;
+using std::runtime_error;
+using std::ifstream;
+using std::ofstream;
+using std::ios;
+using std::istreambuf_iterator;
+using std::getenv;
+using std::int32_t;
+using std::memcpy;
+using std::printf;
+using std::malloc;
+using std::free;
+using std::bad_alloc;
+using std::thread;
+using std::atomic;
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+using std::chrono::nanoseconds;
+
+// gtest/gtest.h
+using testing::TempDir;
+
+// glm/glm.hpp
+using glm::vec2;
+using glm::ivec2;
+
+// Cpp_Utils/JSON.hpp
+using Cpp_Utils::JSON;
+using Cpp_Utils::read_json_file;
+
+// Cpp_Utils/Vector.hpp
+using Cpp_Utils::contains;
+
+// Cpp_Utils/Map.hpp
+using Cpp_Utils::contains_key;
+
+// Game/APIs/Floor_Manager.hpp
+using Game::Tile;
+using Game::Tile_Types;
+using Game::set_obstacle_layouts;
+using Game::generate_floor_rooms;
+using Game::generate_floor_tiles;
+using Game::destroy_floor;
+using Game::iterate_rooms;
+using Game::iterate_room_tiles;
+using Game::get_max_room_id;
+using Game::get_spawn_room_id;
+using Game::get_room_tile;
+using Game::get_floor_size;
+using Game::get_room_tile_width;
+using Game::get_room_tile_height;
+using Game::occupy_random_floor_tile;
+using Game::release_floor_tile;
+using Game::get_free_floor_tile_count;
+using Game::get_room_neighborhood;
+using Game::get_room_stream_changes;
+using Game::get_room_sections;
+using Game::get_room_neighbors;
+using Game::get_room_doors;
+using Game::get_room_depth;
+using Game::get_max_room_depth;
+using Game::Room_Door;
+
+// Game/APIs/Floor_Snapshot.hpp
+using Game::save_floor_snapshot;
+using Game::load_floor_snapshot_layout;
+
+// Game/APIs/Enemy_Manager.hpp
+using Game::generate_enemy_groups;
+using Game::get_enemy_groups;
+
+// Game/APIs/Minimap.hpp
+using Game::generate_minimap_layout;
+using Game::get_minimap_room_count;
+using Game::destroy_minimap;
+
+// Game/APIs/Allocation_Tracker.hpp
+using Game::get_allocation_counts;
+
+// Game/Systems/Wall_Launcher.hpp
+using Game::generate_wall_segments;
+using Game::iterate_wall_segments;
+
+// Game/Systems/Turret.hpp
+using Game::turret_init;
+
+// Game/Utilities.hpp
+using Game::seed_random;
+
+// Game/World.hpp
+using Game::World;
+using Game::set_world;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data Structures
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+struct Benchmark_Result
+{
+    double nanoseconds_per_operation;
+    double allocations_per_operation;
+};
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static const string BASELINE_PATH = "tests/data/generation_benchmarks.json";
+static const unsigned int RANDOM_SEED = 1234;
+static const long long MIN_BENCHMARK_NANOSECONDS = 200000000;
+static const int MAX_BENCHMARK_OPERATIONS = 1000;
+static const double MAX_TIME_REGRESSION = 1.5;
+static const double MAX_ALLOCATION_REGRESSION = 1.1;
+static const double MAX_ALLOCATION_SLACK = 0.1;
+static const vector<int> FLOOR_SIZES { 5, 16, 64, 256 };
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Allocation Tracking
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Builds with GAME_ALLOCATION_TRACKING already replace operator new and delete with the allocation tracker's, so
+// allocations are counted here only when they don't.
+#ifndef GAME_ALLOCATION_TRACKING
+static atomic<long long> allocation_count(0);
+
+
+void * operator new(size_t size)
+{
+    void * memory = malloc(size == 0 ? 1 : size);
+
+    if (memory == nullptr)
+    {
+        throw bad_alloc();
+    }
+
+    allocation_count++;
+    return memory;
+}
+
+
+void * operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+
+void operator delete(void * memory) noexcept
+{
+    free(memory);
+}
+
+
+void operator delete[](void * memory) noexcept
+{
+    free(memory);
+}
+
+
+void operator delete(void * memory, size_t /*size*/) noexcept
+{
+    free(memory);
+}
+
+
+void operator delete[](void * memory, size_t /*size*/) noexcept
+{
+    free(memory);
+}
+#endif
+
+
+static long long get_allocation_count()
+{
+#ifdef GAME_ALLOCATION_TRACKING
+    return get_allocation_counts().allocation_count;
+#else
+    return allocation_count;
+#endif
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static void generation_init()
+{
+    static bool initialized = false;
+
+    if (initialized)
+    {
+        return;
+    }
+
+    set_obstacle_layouts(read_json_file("resources/data/obstacle_layouts.json").get<vector<vector<int>>>());
+    turret_init();
+    initialized = true;
+}
+
+
+static JSON read_baseline()
+{
+    ifstream baseline_file(BASELINE_PATH);
+
+    return baseline_file.good() ? read_json_file(BASELINE_PATH) : JSON::object();
+}
+
+
+static void write_baseline(const JSON & baseline)
+{
+    ofstream baseline_file(BASELINE_PATH);
+    baseline_file << baseline.dump(4) << '\n';
+}
+
+
+// Hashes the current world's floor tiles, enemy groups and wall segments, then destroys the floor.
+static unsigned long long hash_floor()
+{
+    static const unsigned long long HASH_PRIME = 1099511628211ull;
+
+    unsigned long long hash = 14695981039346656037ull;
+    generate_wall_segments();
+
+    const int floor_tiles_width = get_floor_size() * get_room_tile_width();
+    const int floor_tiles_height = get_floor_size() * get_room_tile_height();
+
+    for (int y = 0; y < floor_tiles_height; y++)
+    {
+        for (int x = 0; x < floor_tiles_width; x++)
+        {
+            const Tile tile = get_room_tile(x, y);
+            hash = (hash ^ (((int)tile.type * 31) + ((int)tile.rotation * 7) + (tile.room * 131))) * HASH_PRIME;
+        }
+    }
+
+    for (const auto & enemy_group : get_enemy_groups())
+    {
+        hash = (hash ^ (enemy_group.first + (enemy_group.second.enemies.size() * 17))) * HASH_PRIME;
+
+        for (const int layout : enemy_group.second.layouts)
+        {
+            hash = (hash ^ layout) * HASH_PRIME;
+        }
+    }
+
+    iterate_wall_segments([&](int room, const vec2 * /*tile_positions*/, int tile_position_count) -> void
+    {
+        hash = (hash ^ (room + (tile_position_count * 13))) * HASH_PRIME;
+    });
+
+    destroy_floor();
+    return hash;
+}
+
+
+// Generates a floor from seed in the current world and hashes it.
+static unsigned long long generate_floor_hash(unsigned int seed)
+{
+    seed_random(seed);
+    generate_floor_rooms(16);
+    generate_floor_tiles();
+    generate_enemy_groups();
+    return hash_floor();
+}
+
+
+// Generates a floor's rooms and tiles from seed and hashes only its tiles.
+static unsigned long long generate_floor_tile_hash(unsigned int seed)
+{
+    static const unsigned long long HASH_PRIME = 1099511628211ull;
+
+    unsigned long long hash = 14695981039346656037ull;
+    seed_random(seed);
+    generate_floor_rooms(16);
+    generate_floor_tiles();
+
+    iterate_room_tiles([&](int x, int y, const Tile & tile) -> void
+    {
+        hash = (hash ^ ((x * 73856093) ^ (y * 19349663))) * HASH_PRIME;
+        hash = (hash ^ (((int)tile.type * 31) + ((int)tile.rotation * 7) + (tile.room * 131))) * HASH_PRIME;
+    });
+
+    destroy_floor();
+    return hash;
+}
+
+
+// Snapshots a floor of floor_size the first time it's needed, so every benchmark operation on that floor size can load
+// the same floor instead of generating a new one.
+static const string & get_floor_snapshot_path(int floor_size)
+{
+    static map<int, string> floor_snapshot_paths;
+
+    if (!contains_key(floor_snapshot_paths, floor_size))
+    {
+        const string path = TempDir() + "generation_benchmark_floor_" + std::to_string(floor_size) + ".snapshot";
+        seed_random(RANDOM_SEED);
+        generate_floor_rooms(floor_size);
+        generate_floor_tiles();
+        save_floor_snapshot(path);
+        destroy_floor();
+        floor_snapshot_paths[floor_size] = path;
+    }
+
+    return floor_snapshot_paths.at(floor_size);
+}
+
+
+static void load_benchmark_floor(int floor_size)
+{
+    load_floor_snapshot_layout(get_floor_snapshot_path(floor_size));
+}
+
+
+// Runs operation repeatedly until enough time has been sampled, only timing and counting allocations for operation
+// itself; setup and teardown are run around each operation but excluded from the results.
+static Benchmark_Result run_benchmark(
+    const function<void()> & setup,
+    const function<void()> & operation,
+    const function<void()> & teardown)
+{
+    long long total_nanoseconds = 0;
+    long long total_allocations = 0;
+    int operation_count = 0;
+
+
+    // Warm up first, so containers that keep their capacity between operations have grown to fit before measuring.
+    setup();
+    operation();
+    teardown();
+    seed_random(RANDOM_SEED);
+
+    while (total_nanoseconds < MIN_BENCHMARK_NANOSECONDS && operation_count < MAX_BENCHMARK_OPERATIONS)
+    {
+        setup();
+        const long long start_allocation_count = get_allocation_count();
+        const auto start_time = steady_clock::now();
+        operation();
+        const auto end_time = steady_clock::now();
+        total_allocations += get_allocation_count() - start_allocation_count;
+        total_nanoseconds += duration_cast<nanoseconds>(end_time - start_time).count();
+        operation_count++;
+        teardown();
+    }
+
+    return
+    {
+        (double)total_nanoseconds / operation_count,
+        (double)total_allocations / operation_count,
+    };
+}
+
+
+// Compares result against the recorded baseline for name, or records it as the new baseline instead when
+// GAME_BENCHMARK_UPDATE_BASELINE is set. Baselines are never recorded otherwise, so a missing one fails rather than
+// silently passing. Paths are relative to the repository root, which the tests are run from.
+//
+// Allocations are the same on any machine, so they always gate. Times depend on the machine the baseline was recorded
+// on, so they only gate when GAME_BENCHMARK_CHECK_TIME is set, and are otherwise just reported.
+static void check_benchmark(const string & name, const Benchmark_Result & result)
+{
+    JSON baseline = read_baseline();
+
+    printf(
+        "%-40s %14.0f ns/op %12.1f allocs/op\n",
+        name.c_str(),
+        result.nanoseconds_per_operation,
+        result.allocations_per_operation);
+
+    if (getenv("GAME_BENCHMARK_UPDATE_BASELINE") != nullptr)
+    {
+        baseline[name] =
+        {
+            { "ns_per_op", result.nanoseconds_per_operation },
+            { "allocs_per_op", result.allocations_per_operation },
+        };
+
+        write_baseline(baseline);
+        return;
+    }
+
+    if (baseline.find(name) == baseline.end())
+    {
+        ADD_FAILURE()
+            << "no baseline for " << name << " in " << BASELINE_PATH
+            << "; run with GAME_BENCHMARK_UPDATE_BASELINE set to record one";
+
+        return;
+    }
+
+
+    const JSON & benchmark_baseline = baseline[name];
+    const double baseline_nanoseconds = benchmark_baseline["ns_per_op"].get<double>();
+    const double baseline_allocations = benchmark_baseline["allocs_per_op"].get<double>();
+
+    if (getenv("GAME_BENCHMARK_CHECK_TIME") != nullptr)
+    {
+        EXPECT_LE(result.nanoseconds_per_operation, baseline_nanoseconds * MAX_TIME_REGRESSION) << name;
+    }
+    else if (result.nanoseconds_per_operation > baseline_nanoseconds * MAX_TIME_REGRESSION)
+    {
+        printf(
+            "%-40s %14.0f ns/op exceeds baseline of %.0f ns/op; set GAME_BENCHMARK_CHECK_TIME to fail on this\n",
+            name.c_str(),
+            result.nanoseconds_per_operation,
+            baseline_nanoseconds);
+    }
+
+
+    // Amortized container growth shows up as a fraction of an allocation per operation, so allow a little slack.
+    EXPECT_LE(
+        result.allocations_per_operation,
+        (baseline_allocations * MAX_ALLOCATION_REGRESSION) + MAX_ALLOCATION_SLACK) << name;
+}
+
+
+static void benchmark_floor_pass(
+    const string & pass_name,
+    const function<void(int)> & setup,
+    const function<void(int)> & operation,
+    const function<void()> & teardown)
+{
+    generation_init();
+
+    for (const int floor_size : FLOOR_SIZES)
+    {
+        const Benchmark_Result result = run_benchmark(
+            [&]() -> void { setup(floor_size); },
+            [&]() -> void { operation(floor_size); },
+            teardown);
+
+        check_benchmark(pass_name + "/" + std::to_string(floor_size), result);
+    }
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Correctness Tests
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST(Generation, RoomIdsAreContiguous)
+{
+    generation_init();
+    seed_random(RANDOM_SEED);
+
+    for (const int floor_size : FLOOR_SIZES)
+    {
+        generate_floor_rooms(floor_size);
+        vector<int> room_cell_counts(get_max_room_id() + 1, 0);
+
+        iterate_rooms([&](int /*x*/, int /*y*/, int & room) -> void
+        {
+            ASSERT_GE(room, 0);
+            ASSERT_LE(room, get_max_room_id());
+            room_cell_counts[room]++;
+        });
+
+        for (int room = 1; room <= get_max_room_id(); room++)
+        {
+            EXPECT_GT(room_cell_counts[room], 0) << "room " << room << " on floor size " << floor_size;
+        }
+
+
+        // Spawn and boss rooms are always single cell rooms.
+        EXPECT_EQ(room_cell_counts[get_spawn_room_id()], 1);
+        EXPECT_EQ(room_cell_counts[get_max_room_id()], 1);
+        destroy_floor();
+    }
+}
+
+
+TEST(Generation, EveryRoomHasADoor)
+{
+    generation_init();
+    seed_random(RANDOM_SEED);
+    generate_floor_rooms(16);
+    generate_floor_tiles();
+    vector<int> door_rooms;
+
+    iterate_room_tiles([&](int /*x*/, int /*y*/, const Tile & tile) -> void
+    {
+        if (tile.type == Tile_Types::DOOR && !contains(door_rooms, tile.room))
+        {
+            door_rooms.push_back(tile.room);
+        }
+    });
+
+    EXPECT_EQ((int)door_rooms.size(), get_max_room_id());
+    destroy_floor();
+}
+
+
+TEST(Generation, EnemyGroupsSkipSpawnRoom)
+{
+    generation_init();
+    seed_random(RANDOM_SEED);
+    generate_floor_rooms(16);
+    generate_enemy_groups();
+    const auto & enemy_groups = get_enemy_groups();
+    EXPECT_EQ(enemy_groups.count(get_spawn_room_id()), 0u);
+    EXPECT_EQ((int)enemy_groups.size(), get_max_room_id() - 1);
+
+    for (const auto & enemy_group : enemy_groups)
+    {
+        EXPECT_FALSE(enemy_group.second.enemies.empty());
+    }
+
+    destroy_floor();
+}
+
+
+TEST(Generation, WallSegmentsAreNotEmpty)
+{
+    generation_init();
+    seed_random(RANDOM_SEED);
+    generate_floor_rooms(16);
+    generate_floor_tiles();
+    generate_wall_segments();
+    int wall_segment_count = 0;
+
+    iterate_wall_segments([&](int /*room*/, const vec2 * /*tile_positions*/, int tile_position_count) -> void
+    {
+        EXPECT_GT(tile_position_count, 0);
+        wall_segment_count++;
+    });
+
+    EXPECT_GT(wall_segment_count, 0);
+    destroy_floor();
+}
+
+
+TEST(Generation, FreeFloorTilesAreSampledWithoutReplacement)
+{
+    generation_init();
+    seed_random(RANDOM_SEED);
+    generate_floor_rooms(16);
+    generate_floor_tiles();
+
+    for (int room = 1; room <= get_max_room_id(); room++)
+    {
+        const int free_floor_tile_count = get_free_floor_tile_count(room);
+        vector<ivec2> occupied_tiles;
+        ivec2 tile;
+
+
+        // Every free tile is handed out exactly once before sampling fails.
+        while (occupy_random_floor_tile(occupied_tiles.size(), room, tile))
+        {
+            ASSERT_FALSE(contains(occupied_tiles, tile));
+            ASSERT_EQ(get_room_tile(tile.x, tile.y).type, Tile_Types::FLOOR);
+            ASSERT_EQ(get_room_tile(tile.x, tile.y).room, room);
+            occupied_tiles.push_back(tile);
+        }
+
+        EXPECT_EQ((int)occupied_tiles.size(), free_floor_tile_count);
+        EXPECT_EQ(get_free_floor_tile_count(room), 0);
+
+        for (size_t occupant = 0; occupant < occupied_tiles.size(); occupant++)
+        {
+            release_floor_tile(occupant);
+        }
+
+        EXPECT_EQ(get_free_floor_tile_count(room), free_floor_tile_count);
+    }
+
+    destroy_floor();
+}
+
+
+TEST(Generation, RoomNeighborhoodsAreDoorAdjacent)
+{
+    generation_init();
+    seed_random(RANDOM_SEED);
+    generate_floor_rooms(16);
+    generate_floor_tiles();
+
+    for (int room = 1; room <= get_max_room_id(); room++)
+    {
+        const vector<int> room_neighborhood = get_room_neighborhood(room);
+        ASSERT_GT((int)room_neighborhood.size(), 1);
+        EXPECT_EQ(room_neighborhood[0], room);
+
+
+        // Door adjacency goes both ways.
+        for (size_t i = 1; i < room_neighborhood.size(); i++)
+        {
+            EXPECT_NE(room_neighborhood[i], room);
+            EXPECT_TRUE(contains(get_room_neighborhood(room_neighborhood[i]), room));
+        }
+    }
+
+    destroy_floor();
+}
+
+
+TEST(Generation, WorldsGenerateIndependently)
+{
+    static const int WORLD_COUNT = 4;
+
+    generation_init();
+    vector<unsigned long long> expected_hashes;
+
+    for (int i = 0; i < WORLD_COUNT; i++)
+    {
+        expected_hashes.push_back(generate_floor_hash(RANDOM_SEED + i));
+    }
+
+
+    // Each thread generates the same floor in its own world while the others are generating theirs.
+    vector<World> worlds(WORLD_COUNT);
+    vector<unsigned long long> hashes(WORLD_COUNT);
+    vector<thread> threads;
+
+    for (int i = 0; i < WORLD_COUNT; i++)
+    {
+        threads.emplace_back([&, i]() -> void
+        {
+            set_world(worlds[i]);
+            hashes[i] = generate_floor_hash(RANDOM_SEED + i);
+        });
+    }
+
+    for (thread & world_thread : threads)
+    {
+        world_thread.join();
+    }
+
+    EXPECT_EQ(hashes, expected_hashes);
+}
+
+
+TEST(Generation, RoomGraphMatchesDoorTiles)
+{
+    generation_init();
+    seed_random(RANDOM_SEED);
+    generate_floor_rooms(16);
+    generate_floor_tiles();
+    EXPECT_EQ(get_room_depth(get_spawn_room_id()), 0);
+
+    for (int room = 1; room <= get_max_room_id(); room++)
+    {
+        // Every door is a door tile on the room's side, leading to one of its neighbors.
+        for (const Room_Door & room_door : get_room_doors(room))
+        {
+            const Tile door_tile = get_room_tile(room_door.coordinates.x, room_door.coordinates.y);
+            EXPECT_EQ(door_tile.type, Tile_Types::DOOR);
+            EXPECT_EQ(door_tile.room, room);
+            EXPECT_TRUE(contains(get_room_neighborhood(room), room_door.room));
+        }
+
+
+        // A room is one door deeper than its shallowest neighbor.
+        int shallowest_neighbor_depth = get_max_room_depth();
+
+        for (const int neighbor : get_room_neighbors(room))
+        {
+            if (get_room_depth(neighbor) < shallowest_neighbor_depth)
+            {
+                shallowest_neighbor_depth = get_room_depth(neighbor);
+            }
+        }
+
+        if (room != get_spawn_room_id())
+        {
+            EXPECT_EQ(get_room_depth(room), shallowest_neighbor_depth + 1);
+        }
+
+        EXPECT_LE(get_room_depth(room), get_max_room_depth());
+    }
+
+    destroy_floor();
+}
+
+
+TEST(Generation, RoomSectionsMatchRoomLayout)
+{
+    generation_init();
+    seed_random(RANDOM_SEED);
+    generate_floor_rooms(16);
+    vector<vector<ivec2>> expected_room_sections(get_max_room_id() + 1);
+
+    iterate_rooms([&](int x, int y, int & room) -> void
+    {
+        if (room > 0)
+        {
+            expected_room_sections[room].push_back(ivec2(x, y));
+        }
+    });
+
+
+    // Sections are listed in the same order rooms are iterated, which enemy layouts are assigned in.
+    for (int room = 1; room <= get_max_room_id(); room++)
+    {
+        const auto room_sections = get_room_sections(room);
+        EXPECT_EQ(vector<ivec2>(begin(room_sections), end(room_sections)), expected_room_sections[room]);
+    }
+
+    destroy_floor();
+}
+
+
+TEST(Generation, RoomStreamingFollowsNeighborhood)
+{
+    generation_init();
+    seed_random(RANDOM_SEED);
+    generate_floor_rooms(64);
+
+
+    // Walk from the boss room back to the spawn room through ever shallower rooms, streaming rooms at each step.
+    vector<int> built_rooms = get_room_neighborhood(get_spawn_room_id());
+    vector<int> path { get_max_room_id() };
+
+    while (path.back() != get_spawn_room_id())
+    {
+        for (const int neighbor : get_room_neighbors(path.back()))
+        {
+            if (get_room_depth(neighbor) == get_room_depth(path.back()) - 1)
+            {
+                path.push_back(neighbor);
+                break;
+            }
+        }
+    }
+
+    for (auto room = path.rbegin(); room != path.rend(); room++)
+    {
+        const vector<int> room_neighborhood = get_room_neighborhood(*room);
+        vector<int> released_rooms;
+        vector<int> unbuilt_rooms;
+        get_room_stream_changes(*room, built_rooms, released_rooms, unbuilt_rooms);
+
+        for (const int released_room : released_rooms)
+        {
+            EXPECT_TRUE(contains(built_rooms, released_room));
+            EXPECT_FALSE(contains(room_neighborhood, released_room));
+            built_rooms.erase(find(built_rooms.begin(), built_rooms.end(), released_room));
+        }
+
+        for (const int unbuilt_room : unbuilt_rooms)
+        {
+            EXPECT_FALSE(contains(built_rooms, unbuilt_room));
+            built_rooms.push_back(unbuilt_room);
+        }
+
+
+        // Only the current room's neighborhood stays built, however large the floor is.
+        vector<int> sorted_room_neighborhood = room_neighborhood;
+        sort(built_rooms.begin(), built_rooms.end());
+        sort(sorted_room_neighborhood.begin(), sorted_room_neighborhood.end());
+        EXPECT_EQ(built_rooms, sorted_room_neighborhood);
+    }
+
+    destroy_floor();
+}
+
+
+// Fixed-seed floors' tiles, which the wall tile table and packed tile storage must reproduce exactly. These only change
+// when generation or the obstacle layouts are meant to change.
+TEST(Generation, FloorTilesMatchGoldenHashes)
+{
+    static const vector<unsigned long long> GOLDEN_TILE_HASHES
+    {
+        5082676885028150385ull,
+        15600668880482737101ull,
+        12169718929005972414ull,
+        17099615100435459166ull,
+        6496528862211626621ull,
+        4030220534018587487ull,
+        9812961244827814548ull,
+        172365785155011888ull,
+        16502328076574641498ull,
+        14296906568103814852ull,
+        5494632307397500057ull,
+        13355364004877853093ull,
+        13603686190620857029ull,
+        16621917825323974117ull,
+        15343430167334295969ull,
+        11229683666383870060ull,
+        9073681875753221460ull,
+        2049633960895711013ull,
+        6142707712737036015ull,
+        11099068584427955153ull,
+    };
+
+    generation_init();
+
+    for (size_t i = 0; i < GOLDEN_TILE_HASHES.size(); i++)
+    {
+        EXPECT_EQ(generate_floor_tile_hash(RANDOM_SEED + i), GOLDEN_TILE_HASHES[i]) << "seed " << RANDOM_SEED + i;
+    }
+}
+
+
+TEST(Floor_Snapshot, RoundTripsFloorLayout)
+{
+    const string path = TempDir() + "round_trip_floor.snapshot";
+    generation_init();
+    seed_random(RANDOM_SEED);
+    generate_floor_rooms(16);
+    generate_floor_tiles();
+    generate_enemy_groups();
+    save_floor_snapshot(path);
+    const unsigned long long expected_hash = hash_floor();
+    load_floor_snapshot_layout(path);
+    EXPECT_EQ(hash_floor(), expected_hash);
+}
+
+
+// Floor sizes whose room counts overflow 32 bits, which must be rejected before any section is sized from them.
+TEST(Floor_Snapshot, RejectsOverflowingFloorSizes)
+{
+    // Offsets of the header's floor size and max room id, after its magic and version.
+    static const size_t FLOOR_SIZE_OFFSET = 8;
+    static const size_t MAX_ROOM_ID_OFFSET = 20;
+
+    const string path = TempDir() + "overflowing_floor.snapshot";
+    generation_init();
+    seed_random(RANDOM_SEED);
+    generate_floor_rooms(5);
+    generate_floor_tiles();
+    save_floor_snapshot(path);
+    destroy_floor();
+    ifstream snapshot_file(path, ios::binary);
+    const vector<char> snapshot((istreambuf_iterator<char>(snapshot_file)), istreambuf_iterator<char>());
+    snapshot_file.close();
+
+    for (const int32_t floor_size : { 65536, 1 << 20, 46341 })
+    {
+        vector<char> corrupt_snapshot = snapshot;
+        const int32_t max_room_id = 1;
+        memcpy(&corrupt_snapshot[FLOOR_SIZE_OFFSET], &floor_size, sizeof(floor_size));
+        memcpy(&corrupt_snapshot[MAX_ROOM_ID_OFFSET], &max_room_id, sizeof(max_room_id));
+        ofstream(path, ios::binary).write(corrupt_snapshot.data(), corrupt_snapshot.size());
+        EXPECT_THROW(load_floor_snapshot_layout(path), runtime_error) << "floor size " << floor_size;
+    }
+
+
+    // Room ids can't outnumber the floor's cells.
+    vector<char> corrupt_snapshot = snapshot;
+    const int32_t max_room_id = 25;
+    memcpy(&corrupt_snapshot[MAX_ROOM_ID_OFFSET], &max_room_id, sizeof(max_room_id));
+    ofstream(path, ios::binary).write(corrupt_snapshot.data(), corrupt_snapshot.size());
+    EXPECT_THROW(load_floor_snapshot_layout(path), runtime_error);
+}
+
+
+TEST(Floor_Snapshot, RejectsOutOfRangeRoomIds)
+{
+    const string path = TempDir() + "corrupt_floor.snapshot";
+    generation_init();
+    seed_random(RANDOM_SEED);
+    generate_floor_rooms(16);
+    generate_floor_tiles();
+    const int max_room_id = get_max_room_id();
+
+    for (const int corrupt_room : { -1, max_room_id + 1 })
+    {
+        // Corrupt one empty room cell only while the snapshot is saved.
+        bool corrupted = false;
+
+        iterate_rooms([&](int /*x*/, int /*y*/, int & room) -> void
+        {
+            if (!corrupted && room == 0)
+            {
+                room = corrupt_room;
+                corrupted = true;
+            }
+        });
+
+        save_floor_snapshot(path);
+
+        iterate_rooms([&](int /*x*/, int /*y*/, int & room) -> void
+        {
+            if (room == corrupt_room)
+            {
+                room = 0;
+            }
+        });
+
+        ASSERT_TRUE(corrupted);
+        EXPECT_THROW(load_floor_snapshot_layout(path), runtime_error) << "room " << corrupt_room;
+    }
+
+    destroy_floor();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Benchmarks
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST(Generation_Benchmark, Rooms)
+{
+    benchmark_floor_pass(
+        "rooms",
+        [](int /*floor_size*/) -> void {},
+        [](int floor_size) -> void { generate_floor_rooms(floor_size); },
+        []() -> void { destroy_floor(); });
+}
+
+
+TEST(Generation_Benchmark, WallClassification)
+{
+    benchmark_floor_pass(
+        "wall_classification",
+        load_benchmark_floor,
+        [](int /*floor_size*/) -> void { generate_floor_tiles(); },
+        []() -> void { destroy_floor(); });
+}
+
+
+TEST(Generation_Benchmark, WallSegments)
+{
+    benchmark_floor_pass(
+        "wall_segments",
+        load_benchmark_floor,
+        [](int /*floor_size*/) -> void { generate_wall_segments(); },
+        []() -> void { destroy_floor(); });
+}
+
+
+TEST(Generation_Benchmark, MinimapLayout)
+{
+    benchmark_floor_pass(
+        "minimap_layout",
+        load_benchmark_floor,
+        [](int /*floor_size*/) -> void { generate_minimap_layout(); },
+        []() -> void
+        {
+            EXPECT_GT(get_minimap_room_count(), 0);
+            destroy_minimap();
+            destroy_floor();
+        });
+}
+
+
+TEST(Generation_Benchmark, EnemyGroups)
+{
+    benchmark_floor_pass(
+        "enemy_groups",
+        load_benchmark_floor,
+        [](int /*floor_size*/) -> void { generate_enemy_groups(); },
+        []() -> void { destroy_floor(); });
+}
@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <vector>
+
+#include "Game/APIs/Timer_Wheel.hpp"
+
+
+using std::uint64_t;
+using std::vector;
+
+// Game/APIs/Timer_Wheel.hpp
+using Game::Timer_Handle;
+using Game::timer_wheel_advance;
+using Game::schedule_timer;
+using Game::cancel_timer;
+using Game::is_timer_pending;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Data
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The wheel ticks 128 times a second, with 4 levels of 64 slots.
+static const float TICK_DURATION = 1.0f / 128.0f;
+static const uint64_t MAX_TIMER_TICKS = ((uint64_t)1 << 24) - 1;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Tick counts stay below 2^24, so they and their durations are exact as floats and the wheel is only ever moved on by
+// whole ticks.
+static void advance_ticks(uint64_t ticks)
+{
+    timer_wheel_advance(ticks * TICK_DURATION);
+}
+
+
+static Timer_Handle schedule_counted_timer(uint64_t ticks, int & expiry_count)
+{
+    return schedule_timer(ticks * TICK_DURATION, [&]() -> void
+    {
+        expiry_count++;
+    });
+}
+
+
+// Checks a timer expires on exactly the tick it was scheduled for, and not the one before.
+static void check_timer_expiry(uint64_t ticks)
+{
+    int expiry_count = 0;
+    const Timer_Handle timer_handle = schedule_counted_timer(ticks, expiry_count);
+    advance_ticks(ticks - 1);
+    EXPECT_EQ(expiry_count, 0) << ticks << " ticks";
+    EXPECT_TRUE(is_timer_pending(timer_handle)) << ticks << " ticks";
+    advance_ticks(1);
+    EXPECT_EQ(expiry_count, 1) << ticks << " ticks";
+    EXPECT_FALSE(is_timer_pending(timer_handle)) << ticks << " ticks";
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Tests
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Timers at and either side of where each level starts, scheduled from ticks both aligned and unaligned with the
+// levels' slots, as timers are placed and moved down by the tick they expire on.
+TEST(Timer_Wheel, ExpiresAtLevelBoundaries)
+{
+    static const vector<uint64_t> TIMER_TICKS { 1, 63, 64, 65, 4095, 4096, 4097, 262143, 262144, 262145 };
+    static const vector<uint64_t> START_TICK_OFFSETS { 0, 1, 63, 4000 };
+
+    for (const uint64_t start_tick_offset : START_TICK_OFFSETS)
+    {
+        advance_ticks(start_tick_offset);
+
+        for (const uint64_t timer_ticks : TIMER_TICKS)
+        {
+            check_timer_expiry(timer_ticks);
+        }
+    }
+}
+
+
+TEST(Timer_Wheel, StaleHandlesDontReachReusedTimers)
+{
+    int cancelled_expiry_count = 0;
+    int reused_expiry_count = 0;
+    const Timer_Handle cancelled_timer_handle = schedule_counted_timer(10, cancelled_expiry_count);
+    cancel_timer(cancelled_timer_handle);
+    EXPECT_FALSE(is_timer_pending(cancelled_timer_handle));
+
+
+    // The cancelled timer's slot is the next one handed out, and its stale entry is still in the wheel.
+    const Timer_Handle reused_timer_handle = schedule_counted_timer(10, reused_expiry_count);
+    ASSERT_EQ(reused_timer_handle.index, cancelled_timer_handle.index);
+    EXPECT_NE(reused_timer_handle.generation, cancelled_timer_handle.generation);
+    EXPECT_FALSE(is_timer_pending(cancelled_timer_handle));
+    cancel_timer(cancelled_timer_handle);
+    EXPECT_TRUE(is_timer_pending(reused_timer_handle));
+
+    advance_ticks(10);
+    EXPECT_EQ(cancelled_expiry_count, 0);
+    EXPECT_EQ(reused_expiry_count, 1);
+    EXPECT_FALSE(is_timer_pending(reused_timer_handle));
+}
+
+
+TEST(Timer_Wheel, CallbacksCanScheduleFollowUpTimers)
+{
+    int follow_up_expiry_count = 0;
+    Timer_Handle follow_up_timer_handle {};
+
+    const Timer_Handle timer_handle = schedule_timer(5 * TICK_DURATION, [&]() -> void
+    {
+        follow_up_timer_handle = schedule_counted_timer(64, follow_up_expiry_count);
+    });
+
+    advance_ticks(5);
+    EXPECT_FALSE(is_timer_pending(timer_handle));
+    ASSERT_TRUE(is_timer_pending(follow_up_timer_handle));
+
+
+    // The expired timer is freed before its callback runs, so the follow-up reuses its slot under a new handle.
+    EXPECT_EQ(follow_up_timer_handle.index, timer_handle.index);
+    EXPECT_NE(follow_up_timer_handle.generation, timer_handle.generation);
+    advance_ticks(63);
+    EXPECT_EQ(follow_up_expiry_count, 0);
+    advance_ticks(1);
+    EXPECT_EQ(follow_up_expiry_count, 1);
+}
+
+
+// The wheel is moved on the whole way in one go, which also covers advancing by times too large to step through a tick
+// at a time.
+TEST(Timer_Wheel, ClampsDelaysToMaxTimerTicks)
+{
+    int expiry_count = 0;
+    const Timer_Handle timer_handle = schedule_timer(MAX_TIMER_TICKS * TICK_DURATION * 4.0f, [&]() -> void
+    {
+        expiry_count++;
+    });
+
+    advance_ticks(MAX_TIMER_TICKS - 1);
+    EXPECT_EQ(expiry_count, 0);
+    EXPECT_TRUE(is_timer_pending(timer_handle));
+    advance_ticks(1);
+    EXPECT_EQ(expiry_count, 1);
+    EXPECT_FALSE(is_timer_pending(timer_handle));
+}
+
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+
+#include "Game/Utilities.hpp"
+#include "Game/World.hpp"
+
+
+using std::uint64_t;
+
+// Game/Utilities.hpp
+using Game::random;
+using Game::seed_random;
+
+// Game/World.hpp
+using Game::World;
+using Game::get_world;
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Utilities
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+static uint64_t power_modulo(uint64_t base, uint64_t exponent, uint64_t modulus)
+{
+    uint64_t result = 1;
+    base %= modulus;
+
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+        {
+            result = (result * base) % modulus;
+        }
+
+        base = (base * base) % modulus;
+        exponent >>= 1;
+    }
+
+    return result;
+}
+
+
+// Seeding a linear congruential engine sets its state, so seeding it with the state its multiplier takes to the
+// engine's max makes max its next value.
+static void seed_random_to_max()
+{
+    using Random_Engine = decltype(World::random_engine);
+
+    const uint64_t modulus = Random_Engine::modulus;
+    const uint64_t multiplier_inverse = power_modulo(Random_Engine::multiplier, modulus - 2, modulus);
+    seed_random((unsigned int)((Random_Engine::max() * multiplier_inverse) % modulus));
+}
+
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// Tests
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+TEST(Utilities, RandomFloatsStayBelowMax)
+{
+    seed_random_to_max();
+    ASSERT_EQ(get_world().random_engine(), decltype(World::random_engine)::max());
+
+    seed_random_to_max();
+    EXPECT_LT(random(0.0f, 1.0f), 1.0f);
+    seed_random_to_max();
+    EXPECT_LT(random(-1.0f, 1.0f), 1.0f);
+    seed_random_to_max();
+    EXPECT_GE(random(0.0f, 1.0f), 0.99f);
+    EXPECT_EQ(random(2.5f, 2.5f), 2.5f);
+}